@@ -8,38 +8,263 @@
 #include <cstdlib>
 #include <climits>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #include "ai.h"
+#include "alloc.h"
 #include "controller.h"
+#include "metrics.h"
+#include "trace.h"
+#include "tt.h"
 
  // Profundidad adaptativa segn fase del juego
 #define EARLY_GAME_DEPTH 7
 #define MID_GAME_DEPTH 8
 #define END_GAME_DEPTH 12
 
+// Lmites de las fases del juego (cantidad de fichas)
+#define EARLY_GAME_MAX_PIECES 20
+#define END_GAME_MIN_PIECES 45
+
 // Lmite de nodos para casos extremos
 #define MAX_NODES 500000
 
-// Contador global de nodos explorados
-static int nodesExplored = 0;
+// Casillas vacas desde las que el solver resuelve el final exacto
+#define SOLVER_EMPTIES 12
+
+// Lmite de tiempo por jugada en milisegundos (0: sin lmite)
+#define MOVE_TIME_MS 0
+
+// Hilos por bsqueda (Lazy SMP: los auxiliares comparten la tabla de
+// transposicin con el principal)
+#define SEARCH_THREADS 1
+
+// Cada cuntos nodos se consulta el reloj
+#define TIME_CHECK_INTERVAL 1024
+
+static const SearchParams DEFAULT_SEARCH_PARAMS = {
+    EARLY_GAME_DEPTH,
+    MID_GAME_DEPTH,
+    END_GAME_DEPTH,
+    EARLY_GAME_MAX_PIECES,
+    END_GAME_MIN_PIECES,
+    MAX_NODES,
+    MOVE_TIME_MS,
+    SOLVER_EMPTIES,
+    SEARCH_THREADS,
+};
+
+// Parmetros declarados: nombre en archivo y rango vlido
+static const SearchParamInfo SEARCH_PARAM_INFO[] = {
+    {"early_game_depth", &SearchParams::earlyGameDepth, 1, 16},
+    {"mid_game_depth", &SearchParams::midGameDepth, 1, 16},
+    {"end_game_depth", &SearchParams::endGameDepth, 1, 24},
+    {"early_game_max_pieces", &SearchParams::earlyGameMaxPieces, 4, 40},
+    {"end_game_min_pieces", &SearchParams::endGameMinPieces, 30, 64},
+    {"max_nodes", &SearchParams::maxNodes, 1000, 100000000},
+    {"move_time_ms", &SearchParams::moveTimeMs, 0, 3600000},
+    {"solver_empties", &SearchParams::solverEmpties, 0, 30},
+    {"search_threads", &SearchParams::searchThreads, 1, 256},
+};
+
+#define SEARCH_PARAM_COUNT ((int)(sizeof(SEARCH_PARAM_INFO) / sizeof(SEARCH_PARAM_INFO[0])))
+
+// Parmetros usados por getBestMove()
+static SearchParams searchParams = DEFAULT_SEARCH_PARAMS;
+
+/**
+ * @brief Estado de una bsqueda (permite bsquedas simultneas en varios hilos)
+ */
+struct SearchContext
+{
+    const SearchParams *params;
+    const EvalWeights *weights;
+
+    long long nodesExplored;
+    long long maxNodes;
+
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+
+    const std::atomic<bool> *stop;
+    bool aborted;
+
+    // Publicacin de progreso (opcional)
+    SearchInfoChannel *info;
+    SearchInfo infoSnapshot;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point nextInfoTime;
+
+    // Asignaciones del hilo antes de la bsqueda (ALLOC_TRACKING); se
+    // ajusta en cada porcin, ya que entre porciones el hilo hace otras cosas
+    long long allocationBase;
 
-// Matriz de pesos posicionales (estrategia de Reversi)
+    // Variantes principales por ply (tabla triangular)
+    Square pv[SEARCH_MAX_PLY][SEARCH_MAX_PLY];
+    int pvLength[SEARCH_MAX_PLY];
+};
+
+// Clases de casillas simtricas (estrategia de Reversi)
 // Las esquinas valen mucho, las casillas X (adyacentes a esquinas) son peligrosas
-static const int POSITION_WEIGHTS[BOARD_SIZE][BOARD_SIZE] = {
-    {100, -20,  10,   5,   5,  10, -20, 100},
-    {-20, -50,  -2,  -2,  -2,  -2, -50, -20},
-    { 10,  -2,   5,   1,   1,   5,  -2,  10},
-    {  5,  -2,   1,   0,   0,   1,  -2,   5},
-    {  5,  -2,   1,   0,   0,   1,  -2,   5},
-    { 10,  -2,   5,   1,   1,   5,  -2,  10},
-    {-20, -50,  -2,  -2,  -2,  -2, -50, -20},
-    {100, -20,  10,   5,   5,  10, -20, 100}
+static const int SQUARE_CLASSES[BOARD_SIZE][BOARD_SIZE] = {
+    {0, 1, 2, 3, 3, 2, 1, 0},
+    {1, 4, 5, 6, 6, 5, 4, 1},
+    {2, 5, 7, 8, 8, 7, 5, 2},
+    {3, 6, 8, 9, 9, 8, 6, 3},
+    {3, 6, 8, 9, 9, 8, 6, 3},
+    {2, 5, 7, 8, 8, 7, 5, 2},
+    {1, 4, 5, 6, 6, 5, 4, 1},
+    {0, 1, 2, 3, 3, 2, 1, 0}
 };
 
+// Pesos por defecto de la funcin de evaluacin
+static const EvalWeights DEFAULT_EVAL_WEIGHTS = {{
+    // Pesos posicionales por clase de casilla
+    100, -20, 10, 5, -50, -2, -2, 5, 1, 0,
+    // Movilidad, oponente bloqueado, dominancia de movilidad
+    3, 50, 20,
+    // Bordes, paridad
+    5, 10,
+    // Conteo de fichas: inicio/medio, medio tardo, final
+    0.5F, 2, 5
+}};
+
+// Pesos publicados para la bsqueda (los reemplaza el aprendizaje en lnea)
+static std::atomic<const EvalWeights *> evalWeights(&DEFAULT_EVAL_WEIGHTS);
+
+// Bsquedas que usan cada versin de los pesos: quien los publica libera
+// una versin reemplazada recin cuando ninguna bsqueda la usa
+static std::mutex evalWeightsMutex;
+static std::map<const EvalWeights *, int> evalWeightsUsers;
+
+const EvalWeights &getDefaultEvalWeights()
+{
+    return DEFAULT_EVAL_WEIGHTS;
+}
+
+const EvalWeights *getEvalWeights()
+{
+    return evalWeights.load(std::memory_order_acquire);
+}
+
+void setEvalWeights(const EvalWeights *weights)
+{
+    std::lock_guard<std::mutex> lock(evalWeightsMutex);
+    evalWeights.store(weights, std::memory_order_release);
+}
+
+bool isEvalWeightsInUse(const EvalWeights *weights)
+{
+    std::lock_guard<std::mutex> lock(evalWeightsMutex);
+
+    return (weights == evalWeights.load(std::memory_order_relaxed)) ||
+           evalWeightsUsers.count(weights);
+}
+
+/**
+ * @brief Toma los pesos publicados para una bsqueda
+ */
+static const EvalWeights *acquireEvalWeights()
+{
+    std::lock_guard<std::mutex> lock(evalWeightsMutex);
+
+    const EvalWeights *weights = evalWeights.load(std::memory_order_relaxed);
+    evalWeightsUsers[weights]++;
+
+    return weights;
+}
+
+/**
+ * @brief Devuelve los pesos tomados con acquireEvalWeights()
+ */
+static void releaseEvalWeights(const EvalWeights *weights)
+{
+    std::lock_guard<std::mutex> lock(evalWeightsMutex);
+
+    auto users = evalWeightsUsers.find(weights);
+    if ((users != evalWeightsUsers.end()) && (--users->second == 0))
+        evalWeightsUsers.erase(users);
+}
+
+const SearchParams &getDefaultSearchParams()
+{
+    return DEFAULT_SEARCH_PARAMS;
+}
+
+const SearchParams &getSearchParams()
+{
+    return searchParams;
+}
+
+void setSearchParams(const SearchParams &params)
+{
+    searchParams = params;
+}
+
+int getSearchParamCount()
+{
+    return SEARCH_PARAM_COUNT;
+}
+
+const SearchParamInfo &getSearchParamInfo(int index)
+{
+    return SEARCH_PARAM_INFO[index];
+}
+
+bool loadSearchParams(const char *path, SearchParams &params)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file))
+    {
+        char name[64];
+        int value;
+
+        if (line[0] == '#')
+            continue;
+        if (sscanf(line, " %63[^= \t] = %d", name, &value) != 2)
+            continue;
+
+        for (int i = 0; i < SEARCH_PARAM_COUNT; i++)
+        {
+            const SearchParamInfo &info = SEARCH_PARAM_INFO[i];
+
+            if (strcmp(name, info.name) == 0)
+                params.*info.field = std::min(std::max(value, info.minValue), info.maxValue);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+bool saveSearchParams(const char *path, const SearchParams &params)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "# EDAversi search parameters\n");
+    for (int i = 0; i < SEARCH_PARAM_COUNT; i++)
+        fprintf(file, "%s = %d\n", SEARCH_PARAM_INFO[i].name, params.*SEARCH_PARAM_INFO[i].field);
+
+    fclose(file);
+    return true;
+}
+
 /**
  * @brief Determina la profundidad de bsqueda segn la fase del juego
  */
-int getSearchDepth(GameModel& model)
+int getSearchDepth(GameModel& model, const SearchParams& params)
 {
     int totalPieces = 0;
     for (int y = 0; y < BOARD_SIZE; y++)
@@ -48,26 +273,26 @@ int getSearchDepth(GameModel& model)
                 totalPieces++;
 
     // Juego inicial (4-20 fichas): bsqueda moderada
-    if (totalPieces <= 20)
-        return EARLY_GAME_DEPTH;
+    if (totalPieces <= params.earlyGameMaxPieces)
+        return params.earlyGameDepth;
 
     // Final del juego (45+ fichas): bsqueda exhaustiva
-    if (totalPieces >= 45)
-        return END_GAME_DEPTH;
+    if (totalPieces >= params.endGameMinPieces)
+        return params.endGameDepth;
 
     // Medio juego: bsqueda profunda
-    return MID_GAME_DEPTH;
+    return params.midGameDepth;
 }
 
-/**
- * @brief Funcin de evaluacin avanzada para Reversi
- */
-int evaluate(GameModel& model, Player player)
+void getEvalFeatures(GameModel& model, Player player, float* features)
 {
     Player opponent = (player == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
     Piece playerPiece = (player == PLAYER_WHITE) ? PIECE_WHITE : PIECE_BLACK;
     Piece opponentPiece = (player == PLAYER_WHITE) ? PIECE_BLACK : PIECE_WHITE;
 
+    for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+        features[i] = 0;
+
     int totalPieces = 0;
     for (int y = 0; y < BOARD_SIZE; y++)
         for (int x = 0; x < BOARD_SIZE; x++)
@@ -75,15 +300,14 @@ int evaluate(GameModel& model, Player player)
                 totalPieces++;
 
     // === 1. PESOS POSICIONALES ===
-    int positionalValue = 0;
     for (int y = 0; y < BOARD_SIZE; y++)
     {
         for (int x = 0; x < BOARD_SIZE; x++)
         {
             if (model.board[y][x] == playerPiece)
-                positionalValue += POSITION_WEIGHTS[y][x];
+                features[EVAL_SQUARE_0 + SQUARE_CLASSES[y][x]]++;
             else if (model.board[y][x] == opponentPiece)
-                positionalValue -= POSITION_WEIGHTS[y][x];
+                features[EVAL_SQUARE_0 + SQUARE_CLASSES[y][x]]--;
         }
     }
 
@@ -102,22 +326,20 @@ int evaluate(GameModel& model, Player player)
     Moves opponentMoves;
     getValidMoves(tempModel, opponentMoves);
 
-    int mobilityValue = 0;
     if (totalPieces < 50) // Movilidad importante hasta el final
     {
-        mobilityValue = ((int)playerMoves.size() - (int)opponentMoves.size()) * 3;
+        features[EVAL_MOBILITY] = (float)((int)playerMoves.size() - (int)opponentMoves.size());
 
         // Penalizar severamente si el oponente no tiene movimientos (muy bueno)
         if (opponentMoves.size() == 0 && playerMoves.size() > 0)
-            mobilityValue += 50;
+            features[EVAL_MOBILITY_BLOCK] = 1;
         // Bonus si tenemos muchos movimientos
         if (playerMoves.size() > opponentMoves.size() * 2)
-            mobilityValue += 20;
+            features[EVAL_MOBILITY_DOMINANCE] = 1;
     }
 
     // === 3. ESTABILIDAD DE FICHAS ===
     // Fichas en bordes son ms estables
-    int stabilityValue = 0;
     for (int y = 0; y < BOARD_SIZE; y++)
     {
         for (int x = 0; x < BOARD_SIZE; x++)
@@ -126,36 +348,58 @@ int evaluate(GameModel& model, Player player)
             if (isEdge)
             {
                 if (model.board[y][x] == playerPiece)
-                    stabilityValue += 5;
+                    features[EVAL_EDGES]++;
                 else if (model.board[y][x] == opponentPiece)
-                    stabilityValue -= 5;
+                    features[EVAL_EDGES]--;
             }
         }
     }
 
     // === 4. PARIDAD (en end-game) ===
-    int parityValue = 0;
     if (totalPieces >= 50) // Solo importante al final
     {
         int emptySquares = 64 - totalPieces;
         // Queremos hacer el ltimo movimiento
         if (emptySquares % 2 == 1)
-            parityValue = (model.currentPlayer == player) ? 10 : -10;
+            features[EVAL_PARITY] = (model.currentPlayer == player) ? 1.0F : -1.0F;
     }
 
     // === 5. CONTEO DE FICHAS (ms importante al final) ===
-    int scoreDiff = getScore(model, player) - getScore(model, opponent);
-    int pieceValue = 0;
+    float scoreDiff = (float)(getScore(model, player) - getScore(model, opponent));
 
     if (totalPieces >= 50) // End-game: las fichas importan mucho
-        pieceValue = scoreDiff * 5;
+        features[EVAL_PIECES_END] = scoreDiff;
     else if (totalPieces >= 40) // Late mid-game
-        pieceValue = scoreDiff * 2;
+        features[EVAL_PIECES_LATE] = scoreDiff;
     else // Early-mid game: las fichas importan poco
-        pieceValue = scoreDiff / 2;
+        features[EVAL_PIECES_EARLY] = scoreDiff;
+}
+
+/**
+ * @brief Funcin de evaluacin avanzada para Reversi
+ */
+int evaluate(SearchContext& context, GameModel& model, Player player)
+{
+    float features[EVAL_FEATURE_COUNT];
+    getEvalFeatures(model, player, features);
 
     // Combinar todas las heursticas
-    return positionalValue + mobilityValue + stabilityValue + parityValue + pieceValue;
+    float value = 0;
+    for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+        value += context.weights->weights[i] * features[i];
+
+    return (int)((value >= 0) ? value + 0.5F : value - 0.5F);
+}
+
+int getEvaluation(GameModel& model, Player player)
+{
+    SearchContext context;
+    context.weights = acquireEvalWeights();
+
+    int value = evaluate(context, model, player);
+    releaseEvalWeights(context.weights);
+
+    return value;
 }
 
 /**
@@ -167,6 +411,7 @@ void copyBoard(GameModel& source, GameModel& dest)
         for (int x = 0; x < BOARD_SIZE; x++)
             dest.board[y][x] = source.board[y][x];
 
+    dest.version = source.version;
     dest.currentPlayer = source.currentPlayer;
     dest.gameOver = source.gameOver;
 }
@@ -197,7 +442,7 @@ struct ScoredMove
 /**
  * @brief Ordena movimientos por su valor heurstico (mejora poda alfa-beta)
  */
-void orderMoves(GameModel& model, Moves& moves, Player aiPlayer, bool maximizing)
+void orderMoves(SearchContext& context, GameModel& model, Moves& moves, Player aiPlayer, bool maximizing)
 {
     std::vector<ScoredMove> scoredMoves;
 
@@ -208,7 +453,7 @@ void orderMoves(GameModel& model, Moves& moves, Player aiPlayer, bool maximizing
 
         ScoredMove sm;
         sm.move = move;
-        sm.score = evaluate(newModel, aiPlayer);
+        sm.score = evaluate(context, newModel, aiPlayer);
 
         if (!maximizing)
             sm.score = -sm.score;
@@ -224,30 +469,224 @@ void orderMoves(GameModel& model, Moves& moves, Player aiPlayer, bool maximizing
 }
 
 /**
- * @brief Implementa el algoritmo Minimax con poda Alfa-Beta mejorado
+ * @brief Pasa una jugada (si est en la lista) al principio, sin alterar
+ * el orden del resto
  */
-int alphabeta(GameModel& model, int depth, int alpha, int beta,
-    bool maximizingPlayer, Player aiPlayer)
+static void moveToFront(Moves& moves, Square move)
 {
-    nodesExplored++;
+    for (size_t i = 1; i < moves.size(); i++)
+        if (moves[i].x == move.x && moves[i].y == move.y)
+        {
+            std::rotate(moves.begin(), moves.begin() + i, moves.begin() + i + 1);
+            return;
+        }
+}
 
-    // Poda por cantidad de nodos (emergencia)
-    if (nodesExplored >= MAX_NODES)
-        return evaluate(model, aiPlayer);
+/**
+ * @brief Indica si la bsqueda debe abortarse (nodos, tiempo o stop())
+ */
+static bool isSearchAborted(SearchContext& context)
+{
+    if (context.aborted)
+        return true;
+
+    if ((context.maxNodes > 0) && (context.nodesExplored >= context.maxNodes))
+        context.aborted = true;
+    else if (context.stop && context.stop->load(std::memory_order_relaxed))
+        context.aborted = true;
+    else if (context.hasDeadline &&
+             ((context.nodesExplored % TIME_CHECK_INTERVAL) == 0) &&
+             (std::chrono::steady_clock::now() >= context.deadline))
+        context.aborted = true;
+
+    return context.aborted;
+}
+
+/**
+ * @brief Publica el progreso si pas SEARCH_INFO_INTERVAL (o si se fuerza)
+ */
+static void publishSearchInfo(SearchContext& context, bool force)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (!force && (now < context.nextInfoTime))
+        return;
+
+    context.infoSnapshot.nodes = context.nodesExplored;
+    context.infoSnapshot.allocations = getThreadAllocCounts().allocations - context.allocationBase;
+    context.infoSnapshot.time = std::chrono::duration<double>(now - context.startTime).count();
+    context.info->publish(context.infoSnapshot);
+
+    context.nextInfoTime = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                     std::chrono::duration<double>(SEARCH_INFO_INTERVAL));
+}
+
+/**
+ * @brief Guarda el mejor movimiento, el valor y la variante en el snapshot
+ */
+static void setSearchInfoLine(SearchContext& context, Square move, int score, const Moves& pv)
+{
+    SearchInfo& info = context.infoSnapshot;
+
+    info.bestMove = move;
+    info.score = score;
+    info.pvLength = std::min((int)pv.size(), SEARCH_INFO_MAX_PV);
+    for (int i = 0; i < info.pvLength; i++)
+        info.pv[i] = pv[i];
+}
+
+/**
+ * @brief Guarda la variante principal de un nodo: move + la del hijo
+ */
+static void updatePV(SearchContext& context, int ply, Square move)
+{
+    context.pv[ply][0] = move;
+    for (int i = 0; i < context.pvLength[ply + 1]; i++)
+        context.pv[ply][i + 1] = context.pv[ply + 1][i];
+    context.pvLength[ply] = context.pvLength[ply + 1] + 1;
+}
+
+/**
+ * @brief Jugada raz con su valor y variante principal
+ */
+struct RootMove
+{
+    Square move;
+    int score;
+    Moves pv;
+};
+
+/**
+ * @brief Nodo de la pila explcita de la bsqueda (reemplaza la recursin)
+ */
+struct SearchFrame
+{
+    GameModel model;
+    int depth;
+    int ply;
+    int alpha;
+    int beta;
+    bool maximizing;
+
+    // Sin jugadas: el nico hijo es el mismo tablero con el turno pasado
+    bool pass;
+
+    Moves moves;
+    int moveIndex;
+    int best;
+    Square bestMove;
+
+    // Ventana original (para la cota guardada en la tabla de transposicin)
+    int windowAlpha;
+    int windowBeta;
+    uint64_t hash;
+};
+
+// Un nodo con turno pasado no avanza el ply: hasta dos marcos por ply
+#define SEARCH_MAX_FRAMES (2 * SEARCH_MAX_PLY)
+
+// Cada cuntos nodos se revisa el presupuesto de tiempo de una porcin
+#define SLICE_CHECK_INTERVAL 8
+
+/**
+ * @brief Bsqueda alfa-beta reanudable: toda su pila vive en esta estructura
+ */
+struct SlicedSearch
+{
+    SearchContext context;
+
+    GameModel root;
+    Player aiPlayer;
+    uint64_t rootHash;
+    bool infinite;
+    int searchDepth;
+    int multiPV;
+
+    // Profundizacin iterativa en la raz
+    std::vector<RootMove> rootMoves;
+    int depth;
+    int rootIndex;
+    int rootAlpha;
+    int rootBeta;
+    int searchedMoves;
+
+    SearchFrame frames[SEARCH_MAX_FRAMES];
+    int frameCount;
+
+    bool finished;
+    SearchResult result;
+
+    // Comienzo de la iteracin y de la jugada raz en curso (traza)
+    int64_t iterationStart;
+    int64_t rootMoveStart;
+};
+
+/**
+ * @brief Entra a un nodo: lo resuelve si es una hoja (devuelve true y su
+ * valor) o prepara sus hijos
+ */
+static bool enterNode(SearchContext& context, SearchFrame& frame, Player aiPlayer, int& value)
+{
+    context.nodesExplored++;
+    context.pvLength[frame.ply] = 0;
+
+    // Mtricas y progreso para la interfaz, cada TIME_CHECK_INTERVAL nodos
+    if ((context.nodesExplored % TIME_CHECK_INTERVAL) == 0)
+    {
+        addMetricsNodes(TIME_CHECK_INTERVAL);
+        if (context.info)
+            publishSearchInfo(context, false);
+    }
+
+    // Bsqueda abortada: el resultado se descarta
+    if (isSearchAborted(context))
+    {
+        value = 0;
+        return true;
+    }
 
     // Caso base
-    if (depth == 0 || model.gameOver)
-        return evaluate(model, aiPlayer);
+    if (frame.depth == 0 || frame.model.gameOver || frame.ply >= SEARCH_MAX_PLY - 1)
+    {
+        value = evaluate(context, frame.model, aiPlayer);
+        return true;
+    }
+
+    // Tabla de transposicin: valor ya conocido, o la mejor jugada primero
+    Square ttMove = GAME_INVALID_SQUARE;
+    frame.hash = 0;
+    frame.windowAlpha = frame.alpha;
+    frame.windowBeta = frame.beta;
+    if (isTTEnabled())
+    {
+        TTProbe probe;
+
+        frame.hash = getPositionHash(frame.model, aiPlayer);
+        if (probeTT(frame.hash, probe))
+        {
+            if ((probe.depth >= frame.depth) &&
+                ((probe.bound == TT_BOUND_EXACT) ||
+                 (probe.bound == TT_BOUND_LOWER && probe.score >= frame.beta) ||
+                 (probe.bound == TT_BOUND_UPPER && probe.score <= frame.alpha)))
+            {
+                value = probe.score;
+                return true;
+            }
+
+            ttMove = probe.move;
+        }
+    }
 
     // Obtener movimientos vlidos
-    Moves validMoves;
-    getValidMoves(model, validMoves);
+    frame.moves.clear();
+    getValidMoves(frame.model, frame.moves);
 
     // Si no hay movimientos vlidos, pasar turno
-    if (validMoves.size() == 0)
+    frame.pass = (frame.moves.size() == 0);
+    if (frame.pass)
     {
         GameModel newModel;
-        copyBoard(model, newModel);
+        copyBoard(frame.model, newModel);
         newModel.currentPlayer = (newModel.currentPlayer == PLAYER_WHITE)
             ? PLAYER_BLACK : PLAYER_WHITE;
 
@@ -256,97 +695,506 @@ int alphabeta(GameModel& model, int depth, int alpha, int beta,
         if (opponentMoves.size() == 0)
         {
             newModel.gameOver = true;
-            return evaluate(newModel, aiPlayer);
+            value = evaluate(context, newModel, aiPlayer);
+            return true;
         }
 
-        return alphabeta(newModel, depth - 1, alpha, beta, !maximizingPlayer, aiPlayer);
+        return false;
     }
 
     // ORDENAR MOVIMIENTOS para mejorar poda (movimientos prometedores primero)
-    if (validMoves.size() > 1)
-        orderMoves(model, validMoves, aiPlayer, maximizingPlayer);
+    if (frame.moves.size() > 1)
+    {
+        orderMoves(context, frame.model, frame.moves, aiPlayer, frame.maximizing);
+        moveToFront(frame.moves, ttMove);
+    }
+
+    frame.moveIndex = 0;
+    frame.best = frame.maximizing ? INT_MIN : INT_MAX;
+    frame.bestMove = GAME_INVALID_SQUARE;
+
+    return false;
+}
+
+/**
+ * @brief Comienza una iteracin de la profundizacin iterativa
+ */
+static void startIteration(SlicedSearch& search)
+{
+    search.iterationStart = getTraceTime();
+    search.context.infoSnapshot.depth = search.depth;
+
+    search.rootAlpha = INT_MIN;
+    search.rootBeta = INT_MAX;
+    search.rootIndex = 0;
+    search.searchedMoves = 0;
+}
+
+/**
+ * @brief Cierra una iteracin: ordena las jugadas raz y actualiza el
+ * resultado; decide si profundizar
+ */
+static void finishIteration(SlicedSearch& search)
+{
+    SearchContext& context = search.context;
+    SearchResult& result = search.result;
+    std::vector<RootMove>& rootMoves = search.rootMoves;
+    int searchedMoves = search.searchedMoves;
+
+    traceEvent(TRACE_ITERATION, search.iterationStart, search.depth);
 
-    if (maximizingPlayer)
+    // Iteracin incompleta: se usa la anterior (salvo que no haya)
+    if (context.aborted && (result.depth > 0 || searchedMoves == 0))
     {
-        int maxEval = INT_MIN;
+        search.finished = true;
+        return;
+    }
+
+    std::stable_sort(rootMoves.begin(), rootMoves.begin() + searchedMoves,
+        [](const RootMove& a, const RootMove& b)
+        { return a.score > b.score; });
+
+    result.bestMove = rootMoves[0].move;
+    result.score = rootMoves[0].score;
+    result.depth = search.depth;
+    if (search.rootHash && !context.aborted)
+        storeTT(search.rootHash, search.depth, result.score, TT_BOUND_EXACT, result.bestMove);
+    result.lines.clear();
+    for (int i = 0; i < std::min(search.multiPV, searchedMoves); i++)
+    {
+        SearchLine line;
+        line.move = rootMoves[i].move;
+        line.score = rootMoves[i].score;
+        line.pv = rootMoves[i].pv;
+        result.lines.push_back(line);
+    }
+
+    if (context.info)
+    {
+        setSearchInfoLine(context, result.bestMove, result.score, rootMoves[0].pv);
 
-        for (auto move : validMoves)
+        SearchInfo& snapshot = context.infoSnapshot;
+        snapshot.lineCount = std::min((int)result.lines.size(), SEARCH_INFO_MAX_LINES);
+        for (int i = 0; i < snapshot.lineCount; i++)
         {
-            GameModel newModel;
-            simulateMove(model, move, newModel);
+            snapshot.lineMoves[i] = result.lines[i].move;
+            snapshot.lineScores[i] = result.lines[i].score;
+        }
 
-            int eval = alphabeta(newModel, depth - 1, alpha, beta, false, aiPlayer);
-            maxEval = (eval > maxEval) ? eval : maxEval;
+        publishSearchInfo(context, false);
+    }
 
-            alpha = (eval > alpha) ? eval : alpha;
-            if (beta <= alpha)
-                break; // Poda Beta
+    // Bsqueda abortada, profundidad alcanzada o un solo movimiento posible
+    if (context.aborted ||
+        (search.depth >= search.searchDepth) ||
+        (rootMoves.size() == 1 && !search.infinite))
+    {
+        search.finished = true;
+        return;
+    }
+
+    search.depth++;
+    startIteration(search);
+}
+
+/**
+ * @brief Registra el valor de la jugada raz actual
+ */
+static void finishRootMove(SlicedSearch& search, int value)
+{
+    SearchContext& context = search.context;
+    Square move = search.rootMoves[search.rootIndex].move;
+
+    traceEvent(TRACE_ROOT_MOVE, search.rootMoveStart, move.y * BOARD_SIZE + move.x);
+
+    if (!context.aborted)
+    {
+        RootMove& rootMove = search.rootMoves[search.rootIndex];
+
+        rootMove.score = value;
+        rootMove.pv.assign(1, rootMove.move);
+        rootMove.pv.insert(rootMove.pv.end(), context.pv[1], context.pv[1] + context.pvLength[1]);
+        search.searchedMoves++;
+
+        // Con multi-PV se necesitan valores exactos: sin ventana en la raz
+        if (search.multiPV == 1)
+            search.rootAlpha = std::max(search.rootAlpha, value);
+
+        search.rootIndex++;
+        if (search.rootIndex < (int)search.rootMoves.size())
+            return;
+    }
+
+    finishIteration(search);
+}
+
+/**
+ * @brief Devuelve el valor de un nodo terminado a su padre, cerrando los
+ * padres que terminan con l (poda o sin ms hijos)
+ */
+static void returnValue(SlicedSearch& search, int value)
+{
+    SearchContext& context = search.context;
+
+    while (search.frameCount > 0)
+    {
+        SearchFrame& frame = search.frames[search.frameCount - 1];
+
+        // Turno pasado: el valor del hijo es el del nodo
+        if (frame.pass)
+        {
+            search.frameCount--;
+            continue;
+        }
+
+        Square move = frame.moves[frame.moveIndex];
+
+        if (frame.maximizing)
+        {
+            if (value > frame.best)
+            {
+                frame.best = value;
+                frame.bestMove = move;
+                updatePV(context, frame.ply, move);
+            }
+
+            frame.alpha = (value > frame.alpha) ? value : frame.alpha;
+        }
+        else
+        {
+            if (value < frame.best)
+            {
+                frame.best = value;
+                frame.bestMove = move;
+                updatePV(context, frame.ply, move);
+            }
+
+            frame.beta = (value < frame.beta) ? value : frame.beta;
         }
 
-        return maxEval;
+        frame.moveIndex++;
+
+        // Poda, o no quedan hijos: el nodo termina
+        if ((frame.beta <= frame.alpha) ||
+            (frame.moveIndex == (int)frame.moves.size()))
+        {
+            value = frame.best;
+            if (frame.hash && !context.aborted)
+                storeTT(frame.hash, frame.depth, value,
+                        (value <= frame.windowAlpha)  ? TT_BOUND_UPPER
+                        : (value >= frame.windowBeta) ? TT_BOUND_LOWER
+                                                      : TT_BOUND_EXACT,
+                        frame.bestMove);
+            search.frameCount--;
+            continue;
+        }
+
+        return;
+    }
+
+    finishRootMove(search, value);
+}
+
+/**
+ * @brief Avanza la bsqueda un nodo: entra al siguiente hijo del nodo
+ * actual, o a la siguiente jugada raz
+ */
+static void stepSearch(SlicedSearch& search)
+{
+    SearchFrame& child = search.frames[search.frameCount];
+
+    if (search.frameCount == 0)
+    {
+        RootMove& rootMove = search.rootMoves[search.rootIndex];
+
+        search.rootMoveStart = getTraceTime();
+        simulateMove(search.root, rootMove.move, child.model);
+        child.depth = search.depth - 1;
+        child.ply = 1;
+        child.alpha = search.rootAlpha;
+        child.beta = search.rootBeta;
+
+        // playMove pasa el turno solo si el rival no puede jugar
+        child.maximizing = (child.model.currentPlayer == search.aiPlayer);
     }
     else
     {
-        int minEval = INT_MAX;
+        SearchFrame& frame = search.frames[search.frameCount - 1];
 
-        for (auto move : validMoves)
+        if (frame.pass)
+        {
+            copyBoard(frame.model, child.model);
+            child.model.currentPlayer = (frame.model.currentPlayer == PLAYER_WHITE)
+                ? PLAYER_BLACK : PLAYER_WHITE;
+            child.ply = frame.ply;
+            child.maximizing = !frame.maximizing;
+        }
+        else
         {
-            GameModel newModel;
-            simulateMove(model, move, newModel);
+            simulateMove(frame.model, frame.moves[frame.moveIndex], child.model);
+            child.ply = frame.ply + 1;
+            child.maximizing = (child.model.currentPlayer == search.aiPlayer);
+        }
 
-            int eval = alphabeta(newModel, depth - 1, alpha, beta, true, aiPlayer);
-            minEval = (eval < minEval) ? eval : minEval;
+        child.depth = frame.depth - 1;
+        child.alpha = frame.alpha;
+        child.beta = frame.beta;
+    }
 
-            beta = (eval < beta) ? eval : beta;
-            if (beta <= alpha)
-                break; // Poda Alfa
-        }
+    search.frameCount++;
 
-        return minEval;
+    int value;
+    if (enterNode(search.context, child, search.aiPlayer, value))
+    {
+        search.frameCount--;
+        returnValue(search, value);
     }
 }
 
-Square getBestMove(GameModel& model)
+SearchLimits getDefaultSearchLimits()
 {
+    SearchLimits limits;
+    limits.depth = 0;
+    limits.maxNodes = 0;
+    limits.moveTimeMs = 0;
+    limits.infinite = false;
+    limits.multiPV = 1;
+
+    return limits;
+}
+
+SlicedSearch* startSlicedSearch(GameModel& model,
+    const SearchParams& params,
+    const SearchLimits& limits,
+    const std::atomic<bool>* stop,
+    SearchInfoChannel* info)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    long long allocationBase = getThreadAllocCounts().allocations;
+
+    SlicedSearch* search = new SlicedSearch();
+    SearchResult& result = search->result;
+
+    beginMetricsSearch();
+
+    result.bestMove = GAME_INVALID_SQUARE;
+    result.score = 0;
+    result.depth = 0;
+    result.nodes = 0;
+    result.time = 0;
+    result.allocations = 0;
+
+    search->frameCount = 0;
+    search->finished = true;
+    search->context.weights = nullptr;
+
     Moves validMoves;
-    getValidMoves(model, validMoves);
+    if (!model.gameOver)
+        getValidMoves(model, validMoves);
 
     if (validMoves.size() == 0)
-        return GAME_INVALID_SQUARE;
-
-    if (validMoves.size() == 1)
-        return validMoves[0];
+    {
+        result.allocations = getThreadAllocCounts().allocations - allocationBase;
+        return search;
+    }
 
-    nodesExplored = 0;
+    SearchContext& context = search->context;
+    context.params = &params;
+    context.weights = acquireEvalWeights();
+    context.nodesExplored = 0;
+    context.maxNodes = limits.infinite ? 0 : (limits.maxNodes ? limits.maxNodes : params.maxNodes);
+    int moveTimeMs = limits.infinite ? 0 : (limits.moveTimeMs ? limits.moveTimeMs : params.moveTimeMs);
+    context.hasDeadline = (moveTimeMs > 0);
+    context.deadline = startTime + std::chrono::milliseconds(moveTimeMs);
+    context.stop = stop;
+    context.aborted = false;
+    context.info = info;
+    context.startTime = startTime;
+    context.nextInfoTime = startTime;
+    context.allocationBase = allocationBase;
 
     // Determinar profundidad segn fase del juego
-    int searchDepth = getSearchDepth(model);
+    search->searchDepth = limits.infinite
+                              ? SEARCH_MAX_PLY - 1
+                              : (limits.depth ? limits.depth : getSearchDepth(model, params));
+    search->multiPV = std::max(1, std::min(limits.multiPV, (int)validMoves.size()));
+    search->infinite = limits.infinite;
+
+    copyBoard(model, search->root);
+    search->aiPlayer = model.currentPlayer;
+
+    // Ordenar movimientos en el nodo raz (la mejor jugada de una bsqueda
+    // anterior, si la hay, primero)
+    orderMoves(context, model, validMoves, search->aiPlayer, true);
+    search->rootHash = 0;
+    if (isTTEnabled())
+    {
+        TTProbe probe;
 
-    Square bestMove = validMoves[0];
-    int bestValue = INT_MIN;
-    Player aiPlayer = model.currentPlayer;
+        search->rootHash = getPositionHash(model, search->aiPlayer);
+        if (probeTT(search->rootHash, probe))
+            moveToFront(validMoves, probe.move);
+    }
 
-    int alpha = INT_MIN;
-    int beta = INT_MAX;
+    for (auto move : validMoves)
+    {
+        RootMove rootMove;
+        rootMove.move = move;
+        rootMove.score = INT_MIN;
+        search->rootMoves.push_back(rootMove);
+    }
 
-    // Ordenar movimientos en el nodo raz
-    orderMoves(model, validMoves, aiPlayer, true);
+    result.bestMove = search->rootMoves[0].move;
 
-    for (auto move : validMoves)
+    if (info)
     {
-        GameModel newModel;
-        simulateMove(model, move, newModel);
+        context.infoSnapshot.searching = true;
+        context.infoSnapshot.depth = 0;
+        context.infoSnapshot.lineCount = 0;
+        setSearchInfoLine(context, result.bestMove, 0, Moves(1, result.bestMove));
+        publishSearchInfo(context, true);
+    }
 
-        int moveValue = alphabeta(newModel, searchDepth - 1, alpha, beta, false, aiPlayer);
+    // Profundizacin iterativa: cada iteracin ordena la siguiente
+    search->depth = 1;
+    search->finished = false;
+    startIteration(*search);
 
-        if (moveValue > bestValue)
+    result.allocations = getThreadAllocCounts().allocations - allocationBase;
+
+    return search;
+}
+
+bool runSlicedSearch(SlicedSearch* search, int budgetUs)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::microseconds(budgetUs);
+    int steps = 0;
+
+    search->context.allocationBase = getThreadAllocCounts().allocations - search->result.allocations;
+
+    while (!search->finished)
+    {
+        if ((budgetUs > 0) &&
+            ((++steps % SLICE_CHECK_INTERVAL) == 0) &&
+            (std::chrono::steady_clock::now() >= deadline))
         {
-            bestValue = moveValue;
-            bestMove = move;
+            search->result.allocations = getThreadAllocCounts().allocations - search->context.allocationBase;
+            return false;
         }
 
-        alpha = (moveValue > alpha) ? moveValue : alpha;
+        stepSearch(*search);
     }
 
-    return bestMove;
-}
\ No newline at end of file
+    search->result.allocations = getThreadAllocCounts().allocations - search->context.allocationBase;
+
+    return true;
+}
+
+void endSlicedSearch(SlicedSearch* search, SearchResult* result)
+{
+    SearchContext& context = search->context;
+    context.allocationBase = getThreadAllocCounts().allocations - search->result.allocations;
+
+    endMetricsSearch();
+
+    if (!search->rootMoves.empty())
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+        search->result.nodes = context.nodesExplored;
+        addMetricsNodes(context.nodesExplored % TIME_CHECK_INTERVAL);
+        search->result.time = std::chrono::duration<double>(now - context.startTime).count();
+
+        if (context.info)
+        {
+            context.infoSnapshot.searching = false;
+            context.infoSnapshot.depth = search->result.depth;
+            publishSearchInfo(context, true);
+        }
+    }
+
+    search->result.allocations = getThreadAllocCounts().allocations - context.allocationBase;
+
+    if (result)
+        *result = search->result;
+
+    // Sin jugadas vlidas la bsqueda no lleg a tomar los pesos
+    if (context.weights)
+        releaseEvalWeights(context.weights);
+
+    delete search;
+}
+
+void searchPosition(GameModel& model,
+    const SearchParams& params,
+    const SearchLimits& limits,
+    const std::atomic<bool>* stop,
+    SearchResult& result,
+    SearchInfoChannel* info)
+{
+    // Sin tabla de transposicin los auxiliares no ayudan al principal
+    int helperCount = isTTEnabled() ? params.searchThreads - 1 : 0;
+
+    std::atomic<bool> helperStop(false);
+    std::vector<std::thread> helpers;
+    std::vector<long long> helperNodes(std::max(helperCount, 0));
+    std::vector<long long> helperAllocations(std::max(helperCount, 0));
+
+    SearchParams helperParams = params;
+    helperParams.searchThreads = 1;
+
+    SearchLimits helperLimits = limits;
+    helperLimits.multiPV = 1;
+    if (!limits.infinite && !limits.depth)
+        helperLimits.depth = getSearchDepth(model, params);
+
+    for (int i = 0; i < helperCount; i++)
+    {
+        helpers.push_back(std::thread([&, i]()
+        {
+            setTraceThreadName("helper");
+
+            // La mitad de los auxiliares busca un nivel ms: as llenan
+            // la tabla con resultados que el principal todava no tiene
+            SearchLimits threadLimits = helperLimits;
+            if (!threadLimits.infinite && (i % 2 == 0))
+                threadLimits.depth = std::min(threadLimits.depth + 1, SEARCH_MAX_PLY - 1);
+
+            SearchResult helperResult;
+            SlicedSearch* helper = startSlicedSearch(model, helperParams, threadLimits, &helperStop, nullptr);
+            runSlicedSearch(helper, 0);
+            endSlicedSearch(helper, &helperResult);
+
+            helperNodes[i] = helperResult.nodes;
+            helperAllocations[i] = helperResult.allocations;
+        }));
+    }
+
+    SlicedSearch* search = startSlicedSearch(model, params, limits, stop, info);
+
+    runSlicedSearch(search, 0);
+    endSlicedSearch(search, &result);
+
+    // El resultado es el del hilo principal; los auxiliares se detienen
+    helperStop.store(true, std::memory_order_relaxed);
+    for (int i = 0; i < helperCount; i++)
+    {
+        helpers[i].join();
+        result.nodes += helperNodes[i];
+        result.allocations += helperAllocations[i];
+    }
+}
+
+Square getBestMove(GameModel& model)
+{
+    return getBestMove(model, searchParams);
+}
+
+Square getBestMove(GameModel& model, const SearchParams& params)
+{
+    SearchResult result;
+    searchPosition(model, params, getDefaultSearchLimits(), nullptr, result);
+
+    return result.bestMove;
+}
@@ -8,7 +8,300 @@
 #ifndef AI_H
 #define AI_H
 
+#include <atomic>
+#include <vector>
+
 #include "model.h"
+#include "searchinfo.h"
+
+// Maximum search depth, in plies
+#define SEARCH_MAX_PLY 64
+
+/**
+ * @brief Features of the linear evaluation function.
+ *
+ * The ten EVAL_SQUARE_* features count own minus opponent discs on each
+ * class of symmetric squares (corner, C, A, B, X and the inner squares).
+ */
+enum EvalFeature
+{
+    EVAL_SQUARE_0,
+    EVAL_SQUARE_1,
+    EVAL_SQUARE_2,
+    EVAL_SQUARE_3,
+    EVAL_SQUARE_4,
+    EVAL_SQUARE_5,
+    EVAL_SQUARE_6,
+    EVAL_SQUARE_7,
+    EVAL_SQUARE_8,
+    EVAL_SQUARE_9,
+    EVAL_MOBILITY,
+    EVAL_MOBILITY_BLOCK,
+    EVAL_MOBILITY_DOMINANCE,
+    EVAL_EDGES,
+    EVAL_PARITY,
+    EVAL_PIECES_EARLY,
+    EVAL_PIECES_LATE,
+    EVAL_PIECES_END,
+
+    EVAL_FEATURE_COUNT
+};
+
+struct EvalWeights
+{
+    float weights[EVAL_FEATURE_COUNT];
+};
+
+/**
+ * @brief Search parameters.
+ */
+struct SearchParams
+{
+    int earlyGameDepth;
+    int midGameDepth;
+    int endGameDepth;
+
+    int earlyGameMaxPieces;
+    int endGameMinPieces;
+
+    int maxNodes;
+    int moveTimeMs;
+
+    int solverEmpties;
+
+    // Threads of searchPosition() (Lazy SMP over the transposition table)
+    int searchThreads;
+};
+
+/**
+ * @brief Describes a search parameter: its name and valid range.
+ */
+struct SearchParamInfo
+{
+    const char *name;
+    int SearchParams::*field;
+    int minValue;
+    int maxValue;
+};
+
+/**
+ * @brief Returns the built-in search parameters.
+ *
+ * @return The default parameters.
+ */
+const SearchParams &getDefaultSearchParams();
+
+/**
+ * @brief Returns the search parameters used by getBestMove().
+ *
+ * @return The parameters.
+ */
+const SearchParams &getSearchParams();
+
+/**
+ * @brief Sets the search parameters used by getBestMove().
+ *
+ * @param params The parameters.
+ */
+void setSearchParams(const SearchParams &params);
+
+/**
+ * @brief Returns the number of declared search parameters.
+ *
+ * @return The number of parameters.
+ */
+int getSearchParamCount();
+
+/**
+ * @brief Returns the description of a search parameter.
+ *
+ * @param index The parameter index.
+ * @return The parameter description.
+ */
+const SearchParamInfo &getSearchParamInfo(int index);
+
+/**
+ * @brief Loads search parameters from a "name = value" file.
+ *
+ * Values are clamped to their valid range; missing names keep their value.
+ *
+ * @param path The file.
+ * @param params The parameters.
+ * @return The file could be read.
+ */
+bool loadSearchParams(const char *path, SearchParams &params);
+
+/**
+ * @brief Saves search parameters to a "name = value" file.
+ *
+ * @param path The file.
+ * @param params The parameters.
+ * @return The file could be written.
+ */
+bool saveSearchParams(const char *path, const SearchParams &params);
+
+/**
+ * @brief Returns the built-in evaluation weights.
+ *
+ * @return The default weights.
+ */
+const EvalWeights &getDefaultEvalWeights();
+
+/**
+ * @brief Returns the evaluation weights currently used by the search.
+ *
+ * @return The published weights.
+ */
+const EvalWeights *getEvalWeights();
+
+/**
+ * @brief Publishes new evaluation weights to the search.
+ *
+ * The swap is atomic: a search in progress keeps using the weights it
+ * started with. The caller keeps ownership of the weights, which must
+ * outlive any search that may be using them (see isEvalWeightsInUse).
+ *
+ * @param weights The new weights.
+ */
+void setEvalWeights(const EvalWeights *weights);
+
+/**
+ * @brief Returns whether weights are published or used by a search.
+ *
+ * Once replaced with setEvalWeights(), weights that are not in use can
+ * be freed: no search can pick them up again.
+ *
+ * @param weights The weights.
+ * @return The weights are in use.
+ */
+bool isEvalWeightsInUse(const EvalWeights *weights);
+
+/**
+ * @brief Computes the evaluation features of a position.
+ *
+ * @param model The game model.
+ * @param player The point of view (PLAYER_WHITE or PLAYER_BLACK).
+ * @param features Receives EVAL_FEATURE_COUNT feature values.
+ */
+void getEvalFeatures(GameModel &model, Player player, float *features);
+
+/**
+ * @brief Returns the static evaluation of a position.
+ *
+ * @param model The game model.
+ * @param player The point of view (PLAYER_WHITE or PLAYER_BLACK).
+ * @return The evaluation, with the published weights.
+ */
+int getEvaluation(GameModel &model, Player player);
+
+/**
+ * @brief Limits of a search. Zero values use the search parameters.
+ */
+struct SearchLimits
+{
+    int depth;
+    int maxNodes;
+    int moveTimeMs;
+    bool infinite;
+    int multiPV;
+};
+
+/**
+ * @brief A root move with its score and principal variation.
+ */
+struct SearchLine
+{
+    Square move;
+    int score;
+    Moves pv;
+};
+
+/**
+ * @brief The result of a search.
+ */
+struct SearchResult
+{
+    Square bestMove;
+    int score;
+    int depth;
+    long long nodes;
+    double time;
+
+    // Heap allocations made by the search (ALLOC_TRACKING builds only)
+    long long allocations;
+
+    std::vector<SearchLine> lines;
+};
+
+/**
+ * @brief Returns limits that search as the search parameters say.
+ *
+ * @return The limits.
+ */
+SearchLimits getDefaultSearchLimits();
+
+/**
+ * @brief Searches a position with iterative deepening.
+ *
+ * Scores are from the point of view of the player to move. If the search
+ * is aborted (node or time limit, or stop), the result of the last
+ * complete iteration is returned.
+ *
+ * With params.searchThreads above one (and the transposition table
+ * enabled), helper threads search the same position and share the table.
+ * The result is the calling thread's; nodes include every thread.
+ *
+ * @param model The game model.
+ * @param params The search parameters.
+ * @param limits The search limits.
+ * @param stop Optional flag that aborts the search when set.
+ * @param result Receives the result.
+ * @param info Optional channel that receives progress snapshots every
+ * SEARCH_INFO_INTERVAL seconds, plus one at the start and one at the end.
+ */
+void searchPosition(GameModel &model,
+                    const SearchParams &params,
+                    const SearchLimits &limits,
+                    const std::atomic<bool> *stop,
+                    SearchResult &result,
+                    SearchInfoChannel *info = nullptr);
+
+/**
+ * @brief A resumable search (explicit stack, no recursion).
+ */
+struct SlicedSearch;
+
+/**
+ * @brief Starts a search that runs in slices, on the caller's thread.
+ *
+ * Same search and arguments as searchPosition(). The position is copied;
+ * params, stop and info must stay valid until endSlicedSearch().
+ *
+ * @return The search.
+ */
+SlicedSearch *startSlicedSearch(GameModel &model,
+                                const SearchParams &params,
+                                const SearchLimits &limits,
+                                const std::atomic<bool> *stop,
+                                SearchInfoChannel *info);
+
+/**
+ * @brief Advances a sliced search for a time budget.
+ *
+ * @param search The search.
+ * @param budgetUs The budget in microseconds (0: until it finishes).
+ * @return true if the search finished.
+ */
+bool runSlicedSearch(SlicedSearch *search, int budgetUs);
+
+/**
+ * @brief Ends a sliced search (finished or not) and frees it.
+ *
+ * @param search The search.
+ * @param result Receives the result of the last complete iteration, or
+ * nullptr to discard it.
+ */
+void endSlicedSearch(SlicedSearch *search, SearchResult *result);
 
 /**
  * @brief Returns the best move for a certain position.
@@ -17,4 +310,15 @@
  */
 Square getBestMove(GameModel &model);
 
+/**
+ * @brief Returns the best move for a certain position.
+ *
+ * Safe to call from several threads at once.
+ *
+ * @param model The game model.
+ * @param params The search parameters.
+ * @return The best move.
+ */
+Square getBestMove(GameModel &model, const SearchParams &params);
+
 #endif
@@ -0,0 +1,40 @@
+/**
+ * @brief Implements heap allocation counters
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "alloc.h"
+
+// Contadores por hilo: sin inicializacin dinmica, as se pueden usar
+// desde operator new en cualquier momento de la vida del hilo
+static thread_local AllocCounts threadCounts;
+
+static bool trackingEnabled = false;
+
+void enableAllocTracking()
+{
+    trackingEnabled = true;
+}
+
+bool isAllocTrackingEnabled()
+{
+    return trackingEnabled;
+}
+
+void countAllocation(std::size_t size)
+{
+    threadCounts.allocations++;
+    threadCounts.bytes += size;
+}
+
+void countFree()
+{
+    threadCounts.frees++;
+}
+
+AllocCounts getThreadAllocCounts()
+{
+    return threadCounts;
+}
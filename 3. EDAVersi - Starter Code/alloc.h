@@ -0,0 +1,86 @@
+/**
+ * @brief Implements heap allocation counters, updated by the global
+ * operator new/delete hooks of allochooks.cpp
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+#include <cstddef>
+
+/**
+ * @brief Heap operations of a thread.
+ */
+struct AllocCounts
+{
+    long long allocations;
+    long long frees;
+    long long bytes;
+};
+
+/**
+ * @brief Indicates whether the allocation hooks were compiled in (the
+ * ALLOC_TRACKING build option). Without them all counts are zero.
+ *
+ * @return The hooks are compiled in.
+ */
+bool isAllocTrackingEnabled();
+
+/**
+ * @brief Registers the allocation hooks (called by allochooks.cpp).
+ */
+void enableAllocTracking();
+
+/**
+ * @brief Counts an allocation of the calling thread (allocation hooks).
+ */
+void countAllocation(std::size_t size);
+
+/**
+ * @brief Counts a free of the calling thread (allocation hooks).
+ */
+void countFree();
+
+/**
+ * @brief Returns the heap operations of the calling thread so far.
+ *
+ * @return The counts.
+ */
+AllocCounts getThreadAllocCounts();
+
+/**
+ * @brief Counts the heap operations of the calling thread within a scope.
+ */
+class AllocScope
+{
+public:
+    AllocScope() : start(getThreadAllocCounts())
+    {
+    }
+
+    /**
+     * @brief Returns the heap operations since the scope started.
+     */
+    AllocCounts getCounts() const
+    {
+        AllocCounts counts = getThreadAllocCounts();
+        counts.allocations -= start.allocations;
+        counts.frees -= start.frees;
+        counts.bytes -= start.bytes;
+
+        return counts;
+    }
+
+    long long getAllocations() const
+    {
+        return getThreadAllocCounts().allocations - start.allocations;
+    }
+
+private:
+    AllocCounts start;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @brief Implements the heap allocation hooks (global operator new/delete)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "alloc.h"
+
+#if defined(ALLOC_TRACKING)
+
+// Se compila en cada ejecutable y no en el ncleo del motor: as cada
+// target elige si cuenta sus asignaciones
+static const bool trackingRegistered = (enableAllocTracking(), true);
+
+/**
+ * @brief Allocates and counts; never returns nullptr.
+ */
+static void *allocate(std::size_t size)
+{
+    if (!size)
+        size = 1;
+
+    void *memory;
+    while (!(memory = malloc(size)))
+    {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+
+        handler();
+    }
+
+    countAllocation(size);
+
+    return memory;
+}
+
+static void deallocate(void *memory)
+{
+    if (!memory)
+        return;
+
+    countFree();
+    free(memory);
+}
+
+void *operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void operator delete(void *memory) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+    deallocate(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept
+{
+    deallocate(memory);
+}
+
+#endif
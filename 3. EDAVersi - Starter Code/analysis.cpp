@@ -0,0 +1,28 @@
+/**
+ * @brief Implements the per-position analysis cache read by the UI
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "analysis.h"
+
+static PositionAnalysis analysis;
+
+const PositionAnalysis &getPositionAnalysis(GameModel &model)
+{
+    if (!analysis.valid ||
+        (analysis.version != model.version) ||
+        (analysis.currentPlayer != model.currentPlayer) ||
+        (analysis.gameOver != model.gameOver))
+    {
+        analysis.valid = true;
+        analysis.version = model.version;
+        analysis.currentPlayer = model.currentPlayer;
+        analysis.gameOver = model.gameOver;
+
+        analysis.validMoves = getValidMovesMask(model);
+    }
+
+    return analysis;
+}
@@ -0,0 +1,40 @@
+/**
+ * @brief Implements the per-position analysis cache read by the UI
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include <cstdint>
+
+#include "model.h"
+
+/**
+ * @brief Cached analysis of the current position.
+ */
+struct PositionAnalysis
+{
+    bool valid;
+
+    // Position the analysis belongs to
+    unsigned int version;
+    Player currentPlayer;
+    bool gameOver;
+
+    // Valid moves of the current player (see SQUARE_BIT)
+    uint64_t validMoves;
+};
+
+/**
+ * @brief Returns the analysis of a position, regenerating it only if the
+ * position changed since the last call.
+ *
+ * @param model The game model.
+ * @return The analysis.
+ */
+const PositionAnalysis &getPositionAnalysis(GameModel &model);
+
+#endif
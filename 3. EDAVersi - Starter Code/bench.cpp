@@ -0,0 +1,402 @@
+/**
+ * @brief Benchmark of the rules kernels and the search (no raylib)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ai.h"
+#include "alloc.h"
+#include "model.h"
+#include "perf.h"
+#include "tt.h"
+
+#define DEFAULT_DEPTH 6
+#define DEFAULT_REPEAT 1000
+#define DEFAULT_TT_SIZE_MB 16
+
+// Conjunto de posiciones estndar: partidas al azar con semilla fija,
+// muestreadas cada BENCH_PLY_STEP jugadas
+#define BENCH_SEED 20240501
+#define BENCH_GAMES 12
+#define BENCH_PLY_STEP 10
+
+/**
+ * @brief The measurements of a benchmark.
+ */
+struct BenchResult
+{
+    const char *name;
+
+    long long nodes;
+    double time;
+
+    PerfCounters counters;
+    long long allocations;
+};
+
+// Evita que el compilador descarte el trabajo medido
+static volatile long long benchSink;
+
+/**
+ * @brief Generates the standard position set.
+ */
+static void getBenchPositions(std::vector<GameModel> &positions)
+{
+    std::mt19937 random(BENCH_SEED);
+
+    for (int game = 0; game < BENCH_GAMES; game++)
+    {
+        GameModel model;
+        initModel(model);
+        startModel(model);
+
+        for (int ply = 1; !model.gameOver; ply++)
+        {
+            Moves moves;
+            getValidMoves(model, moves);
+            playMove(model, moves[random() % moves.size()]);
+
+            if (!model.gameOver && ((ply % BENCH_PLY_STEP) == 0))
+                positions.push_back(model);
+        }
+    }
+}
+
+/**
+ * @brief The inputs shared by the benchmarks.
+ */
+struct BenchSet
+{
+    std::vector<GameModel> positions;
+    std::vector<Moves> positionMoves;
+
+    // Repeticiones de los ncleos (la bsqueda corre una vez)
+    int repeat;
+
+    SearchParams params;
+    SearchLimits limits;
+};
+
+static long long benchValidMoves(BenchSet &set, int)
+{
+    long long nodes = 0;
+    long long sink = 0;
+    Moves moves;
+
+    for (int r = 0; r < set.repeat; r++)
+        for (auto &position : set.positions)
+        {
+            moves.clear();
+            getValidMoves(position, moves);
+            sink += moves.size();
+            nodes++;
+        }
+
+    benchSink = sink;
+
+    return nodes;
+}
+
+static long long benchPlayMove(BenchSet &set, int)
+{
+    long long nodes = 0;
+    long long sink = 0;
+
+    for (int r = 0; r < set.repeat; r++)
+        for (size_t i = 0; i < set.positions.size(); i++)
+            for (auto move : set.positionMoves[i])
+            {
+                GameModel model = set.positions[i];
+                playMove(model, move);
+                sink += model.currentPlayer;
+                nodes++;
+            }
+
+    benchSink = sink;
+
+    return nodes;
+}
+
+static long long benchEvaluate(BenchSet &set, int)
+{
+    long long nodes = 0;
+    long long sink = 0;
+
+    for (int r = 0; r < set.repeat; r++)
+        for (auto &position : set.positions)
+        {
+            sink += getEvaluation(position, position.currentPlayer);
+            nodes++;
+        }
+
+    benchSink = sink;
+
+    return nodes;
+}
+
+/**
+ * @brief Searches one position (see setupSearch).
+ */
+static long long benchSearch(BenchSet &set, int index)
+{
+    SearchResult result;
+    searchPosition(set.positions[index], set.params, set.limits, nullptr, result);
+
+    return result.nodes;
+}
+
+/**
+ * @brief Empties the transposition table before each search.
+ */
+static void setupSearch(BenchSet &, int)
+{
+    clearTT();
+}
+
+/**
+ * @brief Measures a benchmark in units: setup() prepares a unit outside
+ * the measurement (nullptr: nothing to prepare) and run() returns the
+ * nodes the unit visited. The measurements of the units add up.
+ */
+static BenchResult runBenchmark(const char *name,
+                                long long (*run)(BenchSet &, int),
+                                void (*setup)(BenchSet &, int),
+                                int units,
+                                BenchSet &set)
+{
+    BenchResult result;
+    result.name = name;
+    result.nodes = 0;
+    result.time = 0;
+    result.allocations = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        result.counters.values[i] = 0;
+        result.counters.available[i] = true;
+    }
+
+    for (int unit = 0; unit < units; unit++)
+    {
+        if (setup)
+            setup(set, unit);
+
+        PerfCounters counters;
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        AllocScope allocScope;
+        startPerfCounters();
+
+        result.nodes += run(set, unit);
+
+        stopPerfCounters(counters);
+        result.allocations += allocScope.getAllocations();
+        result.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+        {
+            result.counters.values[i] += counters.values[i];
+            result.counters.available[i] = result.counters.available[i] && counters.available[i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Prints a counter per node, or n/a.
+ */
+static void printPerNode(const BenchResult &result, PerfCounter counter)
+{
+    if (result.counters.available[counter] && result.nodes)
+        printf(" %9.2f", (double)result.counters.values[counter] / result.nodes);
+    else
+        printf(" %9s", "n/a");
+}
+
+static void printResult(const BenchResult &result)
+{
+    printf("%-12s %12lld %8.3f %9.2f",
+           result.name,
+           result.nodes,
+           result.time,
+           (result.time > 0) ? result.nodes / result.time / 1e6 : 0);
+
+    const PerfCounters &counters = result.counters;
+    if (counters.available[PERF_CYCLES] && counters.available[PERF_INSTRUCTIONS] &&
+        counters.values[PERF_CYCLES])
+        printf(" %6.2f", (double)counters.values[PERF_INSTRUCTIONS] / counters.values[PERF_CYCLES]);
+    else
+        printf(" %6s", "n/a");
+
+    printPerNode(result, PERF_CYCLES);
+    printPerNode(result, PERF_INSTRUCTIONS);
+    printPerNode(result, PERF_CACHE_MISSES);
+    printPerNode(result, PERF_BRANCH_MISSES);
+    printPerNode(result, PERF_TLB_MISSES);
+
+    if (isAllocTrackingEnabled() && result.nodes)
+        printf(" %9.3f", (double)result.allocations / result.nodes);
+    else
+        printf(" %9s", "n/a");
+    printf("\n");
+}
+
+/**
+ * @brief Searches the positions with 1, 2, 4... maxThreads threads and
+ * compares each run with the single-threaded one.
+ */
+static void runScaling(BenchSet &set, int maxThreads, const char *csvPath)
+{
+    FILE *csv = nullptr;
+    if (csvPath)
+    {
+        csv = fopen(csvPath, "w");
+        if (!csv)
+            printf("could not write %s\n", csvPath);
+        else
+            fprintf(csv, "threads,time_s,nodes,nps,speedup,nps_scaling,search_overhead,efficiency\n");
+    }
+
+    // Con ms hilos que ncleos, los hilos se reparten el tiempo: la
+    // aceleracin no dice nada de la bsqueda
+    int cores = (int)std::thread::hardware_concurrency();
+    if (cores && (maxThreads > cores))
+        printf("warning: more threads (%d) than cores (%d), speedup and efficiency\n"
+               "         beyond %d threads are not meaningful\n\n",
+               maxThreads, cores, cores);
+
+    printf("%-8s %8s %12s %9s %8s %8s %9s %10s\n",
+           "threads", "time s", "nodes", "Mnodes/s", "speedup", "nps x", "overhead", "efficiency");
+
+    BenchResult base;
+    for (int threads = 1;; threads = std::min(threads * 2, maxThreads))
+    {
+        set.params.searchThreads = threads;
+        BenchResult result = runBenchmark("search", benchSearch, setupSearch,
+                                          (int)set.positions.size(), set);
+        if (threads == 1)
+            base = result;
+
+        double nps = (result.time > 0) ? result.nodes / result.time : 0;
+        double baseNps = (base.time > 0) ? base.nodes / base.time : 0;
+
+        // Tiempo hasta la profundidad, nodos por segundo y nodos de ms
+        // respecto de un hilo
+        double speedup = (result.time > 0) ? base.time / result.time : 0;
+        double npsScaling = (baseNps > 0) ? nps / baseNps : 0;
+        double overhead = base.nodes ? (double)result.nodes / base.nodes - 1 : 0;
+        double efficiency = speedup / threads;
+
+        printf("%-8d %8.3f %12lld %9.2f %8.2f %8.2f %8.1f%% %9.1f%%\n",
+               threads, result.time, result.nodes, nps / 1e6,
+               speedup, npsScaling, overhead * 100, efficiency * 100);
+        if (csv)
+            fprintf(csv, "%d,%.6f,%lld,%.0f,%.4f,%.4f,%.4f,%.4f\n",
+                    threads, result.time, result.nodes, nps,
+                    speedup, npsScaling, overhead, efficiency);
+
+        if (threads >= maxThreads)
+            break;
+    }
+
+    if (csv)
+        fclose(csv);
+}
+
+static void printUsage()
+{
+    printf("usage: bench [--depth N] [--repeat N] [--no-perf]\n"
+           "             [--scaling] [--max-threads N] [--csv FILE]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int depth = DEFAULT_DEPTH;
+    int repeat = DEFAULT_REPEAT;
+    bool perf = true;
+    bool scaling = false;
+    int maxThreads = (int)std::thread::hardware_concurrency();
+    const char *csvPath = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((i + 1 < argc) && (strcmp(argv[i], "--depth") == 0))
+            depth = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--repeat") == 0))
+            repeat = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--no-perf") == 0)
+            perf = false;
+        else if (strcmp(argv[i], "--scaling") == 0)
+            scaling = true;
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--max-threads") == 0))
+            maxThreads = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--csv") == 0))
+            csvPath = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    depth = std::max(1, std::min(depth, SEARCH_MAX_PLY - 1));
+    repeat = std::max(repeat, 1);
+    maxThreads = std::max(maxThreads, 1);
+
+    BenchSet set;
+    getBenchPositions(set.positions);
+
+    set.positionMoves.resize(set.positions.size());
+    for (size_t i = 0; i < set.positions.size(); i++)
+        getValidMoves(set.positions[i], set.positionMoves[i]);
+
+    set.repeat = repeat;
+
+    set.params = getDefaultSearchParams();
+    set.params.maxNodes = INT_MAX;
+    set.params.moveTimeMs = 0;
+
+    set.limits = getDefaultSearchLimits();
+    set.limits.depth = depth;
+
+    initTT(DEFAULT_TT_SIZE_MB);
+
+    if (perf && !openPerfCounters())
+        printf("hardware counters unavailable: %s\n", getPerfCountersError());
+
+    if (scaling)
+    {
+        printf("%d positions, search depth %d, up to %d threads\n\n",
+               (int)set.positions.size(), depth, maxThreads);
+        runScaling(set, maxThreads, csvPath);
+        closePerfCounters();
+
+        return 0;
+    }
+
+    printf("%d positions, search depth %d, kernels repeated %d times\n\n",
+           (int)set.positions.size(), depth, repeat);
+    printf("%-12s %12s %8s %9s %6s %9s %9s %9s %9s %9s %9s\n",
+           "benchmark", "nodes", "time s", "Mnodes/s", "IPC",
+           "cyc/node", "ins/node", "cache/nd", "branch/nd", "tlb/node", "alloc/nd");
+
+    printResult(runBenchmark("validmoves", benchValidMoves, nullptr, 1, set));
+    printResult(runBenchmark("playmove", benchPlayMove, nullptr, 1, set));
+    printResult(runBenchmark("evaluate", benchEvaluate, nullptr, 1, set));
+    printResult(runBenchmark("search", benchSearch, setupSearch, (int)set.positions.size(), set));
+
+    closePerfCounters();
+
+    return 0;
+}
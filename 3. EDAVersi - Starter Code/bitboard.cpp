@@ -0,0 +1,125 @@
+/**
+ * @brief Implements bitboard move generation and flips
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "bitboard.h"
+
+// Columnas de los bordes: al desplazar, evitan que las fichas pasen de un
+// lado del tablero al otro
+#define FILE_A 0x0101010101010101ULL
+#define FILE_H 0x8080808080808080ULL
+
+#define DIRECTION_COUNT 8
+
+// Desplazamiento de cada direccin (este, oeste, sur, norte y diagonales)
+static const int SHIFTS[DIRECTION_COUNT] = {1, -1, 8, -8, 9, 7, -7, -9};
+
+// Casillas vlidas despus de desplazar en cada direccin
+static const uint64_t SHIFT_MASKS[DIRECTION_COUNT] = {
+    ~FILE_A,
+    ~FILE_H,
+    ~0ULL,
+    ~0ULL,
+    ~FILE_A,
+    ~FILE_H,
+    ~FILE_A,
+    ~FILE_H,
+};
+
+static inline uint64_t shiftDiscs(uint64_t discs, int direction)
+{
+    int shift = SHIFTS[direction];
+
+    return ((shift > 0) ? (discs << shift) : (discs >> -shift)) & SHIFT_MASKS[direction];
+}
+
+Bitboard getBitboard(GameModel &model)
+{
+    Piece playerPiece = (model.currentPlayer == PLAYER_WHITE) ? PIECE_WHITE : PIECE_BLACK;
+
+    Bitboard board = {0, 0};
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+        {
+            Piece piece = model.board[y][x];
+            uint64_t bit = (uint64_t)1 << (y * BOARD_SIZE + x);
+
+            if (piece == playerPiece)
+                board.player |= bit;
+            else if (piece != PIECE_EMPTY)
+                board.opponent |= bit;
+        }
+
+    return board;
+}
+
+uint64_t getBitboardMoves(const Bitboard &board)
+{
+    uint64_t empty = ~(board.player | board.opponent);
+    uint64_t moves = 0;
+
+    for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+    {
+        // Fichas del oponente alineadas con una propia (hasta seis)
+        uint64_t line = shiftDiscs(board.player, direction) & board.opponent;
+        for (int i = 0; i < BOARD_SIZE - 3; i++)
+            line |= shiftDiscs(line, direction) & board.opponent;
+
+        moves |= shiftDiscs(line, direction) & empty;
+    }
+
+    return moves;
+}
+
+uint64_t getBitboardFlips(const Bitboard &board, int square)
+{
+    uint64_t move = (uint64_t)1 << square;
+    uint64_t flips = 0;
+
+    if ((board.player | board.opponent) & move)
+        return 0;
+
+    for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+    {
+        uint64_t line = 0;
+        uint64_t current = shiftDiscs(move, direction);
+
+        while (current & board.opponent)
+        {
+            line |= current;
+            current = shiftDiscs(current, direction);
+        }
+
+        if (current & board.player)
+            flips |= line;
+    }
+
+    return flips;
+}
+
+bool playBitboardMove(Bitboard &board, int square, uint64_t &flips, bool &passed)
+{
+    flips = getBitboardFlips(board, square);
+
+    Bitboard next;
+    next.player = board.opponent & ~flips;
+    next.opponent = board.player | flips | ((uint64_t)1 << square);
+
+    passed = false;
+    if (getBitboardMoves(next))
+    {
+        board = next;
+        return false;
+    }
+
+    // El oponente pasa; si el jugador tampoco puede mover, termina el juego
+    // (como playMove(), el turno queda del jugador que movi)
+    passed = true;
+    board.player = next.opponent;
+    board.opponent = next.player;
+
+    return !getBitboardMoves(board);
+}
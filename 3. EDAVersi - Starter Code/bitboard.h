@@ -0,0 +1,63 @@
+/**
+ * @brief Implements bitboard move generation and flips
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+#include "model.h"
+
+/**
+ * @brief A position as two 64-bit masks (bit y * 8 + x, see SQUARE_BIT).
+ */
+struct Bitboard
+{
+    // Discs of the player to move and of the opponent
+    uint64_t player;
+    uint64_t opponent;
+};
+
+/**
+ * @brief Converts the board of a model, from the point of view of the
+ * player to move.
+ *
+ * @param model The game model.
+ * @return The bitboard.
+ */
+Bitboard getBitboard(GameModel &model);
+
+/**
+ * @brief Returns the legal moves of the player to move.
+ *
+ * @param board The position.
+ * @return The mask of legal squares.
+ */
+uint64_t getBitboardMoves(const Bitboard &board);
+
+/**
+ * @brief Returns the discs flipped by a move.
+ *
+ * @param board The position.
+ * @param square The square index (y * 8 + x).
+ * @return The mask of flipped discs (zero if the move is not legal).
+ */
+uint64_t getBitboardFlips(const Bitboard &board, int square);
+
+/**
+ * @brief Plays a move and handles passes like playMove(): the board is
+ * seen from the next player to move afterwards.
+ *
+ * @param board The position; receives the new position.
+ * @param square The square index of a legal move.
+ * @param flips Receives the flipped discs (see getBitboardFlips).
+ * @param passed Receives whether the opponent had to pass.
+ * @return The game is over.
+ */
+bool playBitboardMove(Bitboard &board, int square, uint64_t &flips, bool &passed);
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @brief Implements an opening book engine
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+
+#include "engine.h"
+
+// Aperturas conocidas; se agregan tambin sus simetras
+static const char *const BOOK_LINES[] = {
+    "f5d6c3d3c4f4f6f3e6e7", // Tiger
+    "f5d6c3d3c4f4c5b3c2",   // Aubrey
+    "f5d6c5f4e3f6d3f3",     // Rose
+    "f5d6c4d3c3",           // No-Kung
+    "f5f6e6f4e3",           // Buffalo
+    "f5f6e6f4g5",           // Heath
+    "f5f4e3f6d3",           // Parallel
+    "f5d6c5f4d3",           // Cow
+    "f5f6e6d6",             // Tamenori
+};
+
+#define BOOK_LINE_COUNT ((int)(sizeof(BOOK_LINES) / sizeof(BOOK_LINES[0])))
+
+/**
+ * @brief Clave de una posicin: tablero y jugador al turno
+ */
+static std::string getPositionKey(const GameModel &model)
+{
+    std::string key(BOARD_SIZE * BOARD_SIZE + 1, '-');
+
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+            if (model.board[y][x] != PIECE_EMPTY)
+                key[y * BOARD_SIZE + x] = (model.board[y][x] == PIECE_BLACK) ? 'X' : 'O';
+
+    key[BOARD_SIZE * BOARD_SIZE] = (model.currentPlayer == PLAYER_BLACK) ? 'X' : 'O';
+
+    return key;
+}
+
+/**
+ * @brief Aplica una de las 8 simetras del tablero
+ */
+static Square transformSquare(Square square, int symmetry)
+{
+    int x = square.x;
+    int y = square.y;
+
+    if (symmetry & 1)
+        x = BOARD_SIZE - 1 - x;
+    if (symmetry & 2)
+        y = BOARD_SIZE - 1 - y;
+    if (symmetry & 4)
+    {
+        int t = x;
+        x = y;
+        y = t;
+    }
+
+    return {x, y};
+}
+
+static bool isValidMove(GameModel &model, Square move)
+{
+    Moves validMoves;
+    getValidMoves(model, validMoves);
+
+    for (auto validMove : validMoves)
+        if ((validMove.x == move.x) && (validMove.y == move.y))
+            return true;
+
+    return false;
+}
+
+class BookEngine : public Engine
+{
+public:
+    BookEngine() : random(std::random_device{}())
+    {
+        for (int i = 0; i < BOOK_LINE_COUNT; i++)
+            for (int symmetry = 0; symmetry < 8; symmetry++)
+                addLine(BOOK_LINES[i], symmetry);
+    }
+
+    const char *getName() const
+    {
+        return ENGINE_BOOK;
+    }
+
+    SearchResult search(const SearchLimits &limits)
+    {
+        SearchResult result;
+        result.bestMove = GAME_INVALID_SQUARE;
+        result.score = 0;
+        result.depth = 0;
+        result.nodes = 1;
+        result.time = 0;
+        result.allocations = 0;
+
+        auto entry = book.find(getPositionKey(position));
+        if (entry != book.end())
+        {
+            const Moves &moves = entry->second;
+            int multiPV = (limits.multiPV > 1) ? limits.multiPV : 1;
+
+            for (int i = 0; (i < (int)moves.size()) && (i < multiPV); i++)
+            {
+                SearchLine line;
+                line.move = moves[i];
+                line.score = 0;
+                line.pv.push_back(moves[i]);
+                result.lines.push_back(line);
+            }
+
+            result.bestMove = moves[random() % moves.size()];
+        }
+
+        endSearch(result);
+
+        return result;
+    }
+
+private:
+    /**
+     * @brief Agrega una lnea; las simetras que no parten de la posicin
+     * inicial generan jugadas invlidas y se descartan
+     */
+    void addLine(const char *line, int symmetry)
+    {
+        GameModel model;
+        initModel(model);
+        startModel(model);
+
+        for (int i = 0; line[i] && line[i + 1]; i += 2)
+        {
+            Square move = getSquareFromName(line + i);
+            if (!isSquareValid(move))
+                return;
+
+            move = transformSquare(move, symmetry);
+            if (!isValidMove(model, move))
+                return;
+
+            Moves &moves = book[getPositionKey(model)];
+            bool found = false;
+            for (auto bookMove : moves)
+                found |= (bookMove.x == move.x) && (bookMove.y == move.y);
+            if (!found)
+                moves.push_back(move);
+
+            playMove(model, move);
+        }
+    }
+
+    std::map<std::string, Moves> book;
+    std::mt19937 random;
+};
+
+Engine *createBookEngine()
+{
+    return new BookEngine();
+}
@@ -0,0 +1,243 @@
+/**
+ * @brief EDAversi engine C API (stable ABI, no raylib)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <climits>
+
+#include "edaversi.h"
+#include "engine.h"
+#include "model.h"
+
+struct edv_engine
+{
+    Engine *engine;
+};
+
+/**
+ * @brief Convierte una posicin de la API al modelo
+ *
+ * @return false si la posicin es invlida.
+ */
+static bool toModel(const edv_position *position, GameModel &model)
+{
+    if (!position ||
+        ((position->side_to_move != EDV_SIDE_BLACK) &&
+         (position->side_to_move != EDV_SIDE_WHITE)))
+        return false;
+
+    initModel(model);
+
+    for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++)
+    {
+        uint8_t piece = position->board[i];
+        if (piece > EDV_WHITE)
+            return false;
+
+        model.board[i / BOARD_SIZE][i % BOARD_SIZE] =
+            (piece == EDV_BLACK) ? PIECE_BLACK : (piece == EDV_WHITE) ? PIECE_WHITE : PIECE_EMPTY;
+    }
+
+    model.currentPlayer = (position->side_to_move == EDV_SIDE_WHITE) ? PLAYER_WHITE : PLAYER_BLACK;
+
+    // Si el jugador en turno no puede jugar, pasa (como en el juego)
+    startModelFromPosition(model);
+
+    return true;
+}
+
+static void fromModel(GameModel &model, edv_position *position)
+{
+    for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++)
+    {
+        Piece piece = model.board[i / BOARD_SIZE][i % BOARD_SIZE];
+        position->board[i] = (piece == PIECE_BLACK) ? EDV_BLACK : (piece == PIECE_WHITE) ? EDV_WHITE : EDV_EMPTY;
+    }
+
+    position->side_to_move = (model.currentPlayer == PLAYER_WHITE) ? EDV_SIDE_WHITE : EDV_SIDE_BLACK;
+}
+
+static int toSquareIndex(Square square)
+{
+    return isSquareValid(square) ? square.y * BOARD_SIZE + square.x : EDV_NO_MOVE;
+}
+
+uint32_t edv_version(void)
+{
+    return EDV_API_VERSION;
+}
+
+edv_engine *edv_create(const char *name)
+{
+    Engine *engine = name ? createEngine(name) : nullptr;
+    if (!engine)
+        return nullptr;
+
+    edv_engine *handle = new edv_engine;
+    handle->engine = engine;
+
+    return handle;
+}
+
+void edv_destroy(edv_engine *engine)
+{
+    if (!engine)
+        return;
+
+    delete engine->engine;
+    delete engine;
+}
+
+int edv_set_position(edv_engine *engine, const edv_position *position)
+{
+    GameModel model;
+
+    if (!engine || !toModel(position, model))
+        return -1;
+
+    engine->engine->setPosition(model);
+
+    return 0;
+}
+
+int edv_search(edv_engine *engine, const edv_limits *limits, edv_result *result)
+{
+    if (!engine || !result)
+        return -1;
+
+    SearchLimits searchLimits = getDefaultSearchLimits();
+    if (limits)
+    {
+        searchLimits.depth = limits->depth;
+        searchLimits.moveTimeMs = limits->move_time_ms;
+        searchLimits.maxNodes = (int)((limits->max_nodes > INT_MAX) ? INT_MAX : limits->max_nodes);
+        searchLimits.multiPV = (limits->multi_pv > 1) ? limits->multi_pv : 1;
+    }
+
+    SearchResult searchResult = engine->engine->search(searchLimits);
+
+    result->best_move = toSquareIndex(searchResult.bestMove);
+    result->score = searchResult.score;
+    result->depth = searchResult.depth;
+    result->nodes = searchResult.nodes;
+    result->time = searchResult.time;
+
+    return 0;
+}
+
+void edv_stop(edv_engine *engine)
+{
+    if (engine)
+        engine->engine->stop();
+}
+
+void edv_start_position(edv_position *position)
+{
+    GameModel model;
+
+    if (!position)
+        return;
+
+    initModel(model);
+    startModel(model);
+    fromModel(model, position);
+}
+
+uint64_t edv_legal_moves(const edv_position *position)
+{
+    GameModel model;
+
+    if (!toModel(position, model))
+        return 0;
+
+    return getValidMovesMask(model);
+}
+
+int edv_make_move(edv_position *position, int32_t square)
+{
+    GameModel model;
+
+    if ((square < 0) || (square >= BOARD_SIZE * BOARD_SIZE) || !toModel(position, model))
+        return -1;
+
+    if (!(getValidMovesMask(model) & ((uint64_t)1 << square)))
+        return -1;
+
+    // playMove pasa el turno automticamente si el rival no puede jugar
+    playMove(model, {square % BOARD_SIZE, square / BOARD_SIZE});
+    fromModel(model, position);
+
+    return 0;
+}
+
+int edv_is_game_over(const edv_position *position)
+{
+    GameModel model;
+
+    if (!toModel(position, model))
+        return -1;
+
+    return model.gameOver ? 1 : 0;
+}
+
+int edv_search_batch(edv_engine *engine,
+                     const edv_position *positions,
+                     size_t count,
+                     const edv_limits *limits,
+                     edv_result *results)
+{
+    int status = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((edv_set_position(engine, &positions[i]) != 0) ||
+            (edv_search(engine, limits, &results[i]) != 0))
+        {
+            results[i].best_move = EDV_NO_MOVE;
+            results[i].score = 0;
+            results[i].depth = 0;
+            results[i].nodes = 0;
+            results[i].time = 0;
+            status = -1;
+        }
+    }
+
+    return status;
+}
+
+void edv_legal_moves_batch(const edv_position *positions,
+                           size_t count,
+                           uint64_t *masks)
+{
+    for (size_t i = 0; i < count; i++)
+        masks[i] = edv_legal_moves(&positions[i]);
+}
+
+void edv_make_move_batch(edv_position *positions,
+                         const int32_t *squares,
+                         size_t count,
+                         int32_t *status)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        int result = edv_make_move(&positions[i], squares[i]);
+        if (status)
+            status[i] = result;
+    }
+}
+
+void edv_evaluate_batch(const edv_position *positions,
+                        size_t count,
+                        int32_t *scores)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        GameModel model;
+
+        scores[i] = toModel(&positions[i], model)
+                        ? getEvaluation(model, model.currentPlayer)
+                        : 0;
+    }
+}
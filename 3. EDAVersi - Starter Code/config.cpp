@@ -0,0 +1,426 @@
+/**
+ * @brief Implements the runtime engine configuration
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "config.h"
+#include "engine.h"
+#include "tournament.h"
+
+#define CONFIG_FILE "edaversi.conf"
+#define PARAMS_FILE "params.txt"
+#define WEIGHTS_FILE "weights.txt"
+#define TELEMETRY_FILE "telemetry.txt"
+#define TRACE_FILE "trace.json"
+
+/**
+ * @brief A configuration option.
+ *
+ * Search options are declared in ai.cpp (see getSearchParamInfo()).
+ */
+struct ConfigOption
+{
+    const char *name;
+    int Config::*intField;
+    std::string Config::*stringField;
+    int minValue;
+    int maxValue;
+    const char *const *choices;
+    bool reloadable;
+};
+
+// Opciones generales; las de recursos solo se leen al iniciar
+static const ConfigOption CONFIG_OPTIONS[] = {
+    {"engine", nullptr, &Config::engine, 0, 0, ENGINE_NAMES, true},
+    {"hints", &Config::hints, nullptr, 0, 1, nullptr, true},
+    {"search_slice_us", &Config::searchSliceUs, nullptr, 0, 1000000, nullptr, true},
+    {"review", &Config::review, nullptr, 0, 1, nullptr, true},
+    {"review_depth", &Config::reviewDepth, nullptr, 1, 24, nullptr, true},
+    {"review_time_ms", &Config::reviewTimeMs, nullptr, 0, 60000, nullptr, true},
+    {"review_threads", &Config::reviewThreads, nullptr, 0, 256, nullptr, true},
+    {"spectate_boards", &Config::spectateBoards, nullptr, 0, TOURNAMENT_MAX_BOARDS, nullptr, false},
+    {"spectate_threads", &Config::spectateThreads, nullptr, 0, 256, nullptr, false},
+    {"match_black", nullptr, &Config::matchBlack, 0, 0, ENGINE_NAMES, false},
+    {"match_white", nullptr, &Config::matchWhite, 0, 0, ENGINE_NAMES, false},
+    {"match_move_time_ms", &Config::matchMoveTimeMs, nullptr, 1, 60000, nullptr, false},
+    {"learn", &Config::learn, nullptr, 0, 1, nullptr, false},
+    {"selfplay_games", &Config::selfPlayGames, nullptr, 0, 1000000, nullptr, false},
+    {"weights_file", nullptr, &Config::weightsFile, 0, 0, nullptr, false},
+    {"tt_size_mb", &Config::ttSizeMB, nullptr, 0, 4096, nullptr, false},
+    {"telemetry_file", nullptr, &Config::telemetryFile, 0, 0, nullptr, false},
+    {"latency_report", &Config::latencyReport, nullptr, 0, 1, nullptr, false},
+    {"trace", &Config::trace, nullptr, 0, 1, nullptr, false},
+    {"trace_file", nullptr, &Config::traceFile, 0, 0, nullptr, false},
+    {"metrics", &Config::metrics, nullptr, 0, 1, nullptr, false},
+};
+
+#define CONFIG_OPTION_COUNT ((int)(sizeof(CONFIG_OPTIONS) / sizeof(CONFIG_OPTIONS[0])))
+
+/**
+ * @brief A "name = value" setting, from a file or the command line.
+ */
+struct ConfigSetting
+{
+    std::string name;
+    std::string value;
+    std::string origin;
+};
+
+static Config config;
+
+static std::string configPath = CONFIG_FILE;
+static time_t configModified = 0;
+
+// Ajustes de la lnea de comandos: se vuelven a aplicar en cada recarga
+static std::vector<ConfigSetting> commandLineSettings;
+
+static void initDefaults(Config &config)
+{
+    config.search = getDefaultSearchParams();
+    config.engine = ENGINE_ALPHABETA;
+    config.hints = 0;
+    config.searchSliceUs = 0;
+    config.review = 1;
+    config.reviewDepth = 6;
+    config.reviewTimeMs = 0;
+    config.reviewThreads = 0;
+    config.spectateBoards = 0;
+    config.spectateThreads = 0;
+    config.matchBlack = ENGINE_ALPHABETA;
+    config.matchWhite = ENGINE_MCTS;
+    config.matchMoveTimeMs = 200;
+    config.learn = 0;
+    config.selfPlayGames = 0;
+    config.weightsFile = WEIGHTS_FILE;
+    config.ttSizeMB = 16;
+    config.telemetryFile = TELEMETRY_FILE;
+    config.latencyReport = 0;
+    config.trace = 0;
+    config.traceFile = TRACE_FILE;
+    config.metrics = 0;
+}
+
+/**
+ * @brief Parses an integer, rejecting trailing garbage and values out of
+ * the range of int.
+ */
+static bool parseInt(const std::string &s, int &value)
+{
+    char *end;
+    errno = 0;
+    long result = strtol(s.c_str(), &end, 10);
+
+    if (s.empty() || (*end != '\0') || (errno == ERANGE))
+        return false;
+    if ((result < INT_MIN) || (result > INT_MAX))
+        return false;
+
+    value = (int)result;
+    return true;
+}
+
+/**
+ * @brief Applies a setting, validating its name and range.
+ *
+ * @param startup Resource options may only be set at startup.
+ * @return The setting is valid.
+ */
+static bool applySetting(Config &config, const ConfigSetting &setting, bool startup)
+{
+    int value = 0;
+
+    for (int i = 0; i < getSearchParamCount(); i++)
+    {
+        const SearchParamInfo &info = getSearchParamInfo(i);
+
+        if (setting.name != info.name)
+            continue;
+
+        if (!parseInt(setting.value, value) ||
+            (value < info.minValue) ||
+            (value > info.maxValue))
+        {
+            fprintf(stderr, "%s: %s must be an integer in [%d, %d]\n",
+                    setting.origin.c_str(), info.name, info.minValue, info.maxValue);
+            return false;
+        }
+
+        config.search.*info.field = value;
+        return true;
+    }
+
+    for (int i = 0; i < CONFIG_OPTION_COUNT; i++)
+    {
+        const ConfigOption &option = CONFIG_OPTIONS[i];
+
+        if (setting.name != option.name)
+            continue;
+
+        // Las opciones de recursos no cambian en una recarga
+        if (!startup && !option.reloadable)
+            return true;
+
+        if (option.stringField)
+        {
+            bool valid = !option.choices;
+            for (int j = 0; option.choices && option.choices[j]; j++)
+                valid |= (setting.value == option.choices[j]);
+
+            if (!valid)
+            {
+                fprintf(stderr, "%s: invalid value for %s\n",
+                        setting.origin.c_str(), option.name);
+                return false;
+            }
+
+            config.*option.stringField = setting.value;
+            return true;
+        }
+
+        if (!parseInt(setting.value, value) ||
+            (value < option.minValue) ||
+            (value > option.maxValue))
+        {
+            fprintf(stderr, "%s: %s must be an integer in [%d, %d]\n",
+                    setting.origin.c_str(), option.name, option.minValue, option.maxValue);
+            return false;
+        }
+
+        config.*option.intField = value;
+        return true;
+    }
+
+    fprintf(stderr, "%s: unknown option %s\n",
+            setting.origin.c_str(), setting.name.c_str());
+    return false;
+}
+
+static std::string trim(const std::string &s)
+{
+    size_t begin = s.find_first_not_of(" \t\r\n");
+    size_t end = s.find_last_not_of(" \t\r\n");
+
+    return (begin == std::string::npos) ? "" : s.substr(begin, end - begin + 1);
+}
+
+/**
+ * @brief Reads the "name = value" settings of a file.
+ *
+ * @return false if the file has syntax errors. A missing file is empty.
+ */
+static bool readSettings(const std::string &path, std::vector<ConfigSetting> &settings)
+{
+    FILE *file = fopen(path.c_str(), "r");
+    if (!file)
+        return true;
+
+    bool valid = true;
+    char line[512];
+    int lineNumber = 0;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        lineNumber++;
+
+        std::string s = line;
+        s = trim(s.substr(0, s.find('#')));
+        if (s.empty())
+            continue;
+
+        ConfigSetting setting;
+        setting.origin = path + ":" + std::to_string(lineNumber);
+
+        size_t equals = s.find('=');
+        if (equals == std::string::npos)
+        {
+            fprintf(stderr, "%s: expected name = value\n", setting.origin.c_str());
+            valid = false;
+            continue;
+        }
+
+        setting.name = trim(s.substr(0, equals));
+        setting.value = trim(s.substr(equals + 1));
+        settings.push_back(setting);
+    }
+
+    fclose(file);
+    return valid;
+}
+
+static time_t getModifiedTime(const std::string &path)
+{
+    struct stat info;
+
+    return (stat(path.c_str(), &info) == 0) ? info.st_mtime : 0;
+}
+
+/**
+ * @brief Builds a configuration from the defaults, the files and the
+ * command line.
+ *
+ * @param startup Resource options are only read at startup.
+ */
+static bool loadConfig(Config &newConfig, bool startup)
+{
+    initDefaults(newConfig);
+    if (!startup)
+    {
+        newConfig.spectateBoards = config.spectateBoards;
+        newConfig.spectateThreads = config.spectateThreads;
+        newConfig.matchBlack = config.matchBlack;
+        newConfig.matchWhite = config.matchWhite;
+        newConfig.matchMoveTimeMs = config.matchMoveTimeMs;
+        newConfig.learn = config.learn;
+        newConfig.selfPlayGames = config.selfPlayGames;
+        newConfig.weightsFile = config.weightsFile;
+        newConfig.ttSizeMB = config.ttSizeMB;
+        newConfig.telemetryFile = config.telemetryFile;
+        newConfig.latencyReport = config.latencyReport;
+        newConfig.trace = config.trace;
+        newConfig.traceFile = config.traceFile;
+        newConfig.metrics = config.metrics;
+    }
+
+    // Parmetros ajustados por el tuner (se recortan a su rango)
+    loadSearchParams(PARAMS_FILE, newConfig.search);
+
+    std::vector<ConfigSetting> settings;
+    bool valid = readSettings(configPath, settings);
+
+    settings.insert(settings.end(), commandLineSettings.begin(), commandLineSettings.end());
+    for (auto &setting : settings)
+        valid &= applySetting(newConfig, setting, startup);
+
+    return valid;
+}
+
+static void printUsage(const char *program)
+{
+    printf("usage: %s [--config FILE] [--learn] [--selfplay N] [--spectate N] [--latency] [--NAME=VALUE ...]\n\n"
+           "options:\n",
+           program);
+
+    for (int i = 0; i < getSearchParamCount(); i++)
+    {
+        const SearchParamInfo &info = getSearchParamInfo(i);
+        printf("  %-24s [%d, %d]\n", info.name, info.minValue, info.maxValue);
+    }
+    for (int i = 0; i < CONFIG_OPTION_COUNT; i++)
+    {
+        const ConfigOption &option = CONFIG_OPTIONS[i];
+        if (option.choices)
+        {
+            printf("  %-24s", option.name);
+            for (int j = 0; option.choices[j]; j++)
+                printf(" %s", option.choices[j]);
+            printf("\n");
+        }
+        else if (option.stringField)
+            printf("  %-24s path\n", option.name);
+        else
+            printf("  %-24s [%d, %d]\n", option.name, option.minValue, option.maxValue);
+    }
+}
+
+bool initConfig(int argc, char *argv[])
+{
+    commandLineSettings.clear();
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        ConfigSetting setting;
+        setting.origin = "command line";
+
+        if ((arg == "--config") && (i + 1 < argc))
+        {
+            configPath = argv[++i];
+            continue;
+        }
+        else if (arg == "--learn")
+        {
+            setting.name = "learn";
+            setting.value = "1";
+        }
+        else if ((arg == "--selfplay") && (i + 1 < argc))
+        {
+            setting.name = "selfplay_games";
+            setting.value = argv[++i];
+        }
+        else if ((arg == "--spectate") && (i + 1 < argc))
+        {
+            setting.name = "spectate_boards";
+            setting.value = argv[++i];
+        }
+        else if (arg == "--latency")
+        {
+            setting.name = "latency_report";
+            setting.value = "1";
+        }
+        else if ((arg.compare(0, 2, "--") == 0) && (arg.find('=') != std::string::npos))
+        {
+            size_t equals = arg.find('=');
+            setting.name = arg.substr(2, equals - 2);
+            setting.value = arg.substr(equals + 1);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        commandLineSettings.push_back(setting);
+    }
+
+    Config newConfig;
+    if (!loadConfig(newConfig, true))
+        return false;
+
+    // El self-play aprende de sus partidas
+    if (newConfig.selfPlayGames > 0)
+        newConfig.learn = 1;
+
+    config = newConfig;
+    configModified = getModifiedTime(configPath);
+    setSearchParams(config.search);
+
+    return true;
+}
+
+const Config &getConfig()
+{
+    return config;
+}
+
+bool updateConfig(bool force)
+{
+    time_t modified = getModifiedTime(configPath);
+    if (!force && (modified == configModified))
+        return false;
+
+    configModified = modified;
+
+    Config newConfig;
+    if (!loadConfig(newConfig, false))
+    {
+        fprintf(stderr, "%s: invalid configuration, keeping the current one\n",
+                configPath.c_str());
+        return false;
+    }
+
+    config = newConfig;
+    setSearchParams(config.search);
+
+    return true;
+}
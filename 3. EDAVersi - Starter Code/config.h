@@ -0,0 +1,83 @@
+/**
+ * @brief Implements the runtime engine configuration
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <string>
+
+#include "ai.h"
+
+/**
+ * @brief Engine configuration.
+ *
+ * Values come from the built-in defaults, then the tuned parameters file,
+ * then the configuration file and finally the command line.
+ */
+struct Config
+{
+    // Search (reloadable between moves)
+    SearchParams search;
+    std::string engine;
+
+    // Interface (reloadable between moves)
+    int hints;
+    int searchSliceUs;
+
+    // Post-game review (reloadable between moves)
+    int review;
+    int reviewDepth;
+    int reviewTimeMs;
+    int reviewThreads;
+
+    // Spectator mode (read at startup only)
+    int spectateBoards;
+    int spectateThreads;
+    std::string matchBlack;
+    std::string matchWhite;
+    int matchMoveTimeMs;
+
+    // Resources (read at startup only)
+    int learn;
+    int selfPlayGames;
+    std::string weightsFile;
+    int ttSizeMB;
+    std::string telemetryFile;
+    int latencyReport;
+    int trace;
+    std::string traceFile;
+    int metrics;
+};
+
+/**
+ * @brief Loads the configuration from the files and the command line.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments.
+ * @return false if the configuration is invalid.
+ */
+bool initConfig(int argc, char *argv[]);
+
+/**
+ * @brief Returns the current configuration.
+ *
+ * @return The configuration.
+ */
+const Config &getConfig();
+
+/**
+ * @brief Reloads the configuration file if it changed since it was read.
+ *
+ * Call only between moves. An invalid file is rejected as a whole and the
+ * current configuration is kept.
+ *
+ * @param force Reload even if the file did not change.
+ * @return The configuration was reloaded.
+ */
+bool updateConfig(bool force = false);
+
+#endif
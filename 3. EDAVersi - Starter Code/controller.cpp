@@ -6,72 +6,637 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
 
 #include "raylib.h"
 
 #include "ai.h"
+#include "analysis.h"
+#include "config.h"
+#include "engine.h"
+#include "learn.h"
+#include "review.h"
+#include "telemetry.h"
+#include "threads.h"
+#include "trace.h"
 #include "view.h"
 #include "controller.h"
 
+// Partida en curso, para el aprendizaje en lnea
+static GameRecord gameRecord;
+
+// Jugadas de la partida en curso (deshacer, rehacer y exportar)
+#define TRANSCRIPT_FILE "game.txt"
+#define REVIEW_FILE "review.csv"
+
+static GameHistory gameHistory;
+
+// Motor de la IA, elegido por configuracin
+static std::unique_ptr<Engine> engine;
+
+// Bsqueda de la IA en un hilo propio, para no bloquear la interfaz
+static std::thread aiThread;
+static std::atomic<bool> aiDone;
+static bool aiThinking;
+static SearchResult aiResult;
+
+// Comienzo de la bsqueda, para la telemetra de latencia
+static std::chrono::steady_clock::time_point aiStartTime;
+
+// Sin hilos (search_slice_us > 0): bsqueda alfa-beta en porciones por cuadro
+static SlicedSearch *aiSlicedSearch;
+static SearchParams aiSlicedParams;
+
+// Progreso de la bsqueda de la IA, ledo por la vista
+static SearchInfoChannel aiSearchInfo;
+
+// Pistas: bsqueda multi-PV de baja prioridad durante el turno del humano
+#define HINT_MULTI_PV (BOARD_SIZE * BOARD_SIZE)
+
+static std::thread hintThread;
+static std::atomic<bool> hintStop;
+static bool hintRunning;
+static bool hintsToggled;
+static GameModel hintPosition;
+static SearchInfoChannel hintSearchInfo;
+
+// Anlisis infinito (A) de la posicin mostrada; se reinicia cuando cambia
+static std::thread analysisThread;
+static std::atomic<bool> analysisStop;
+static bool analysisRunning;
+static bool analysisEnabled;
+static GameModel analysisPosition;
+static SearchInfoChannel analysisSearchInfo;
+
+// Editor de posiciones (F2)
+static bool editing;
+
+/**
+ * @brief Returns the configured engine, creating it if it changed.
+ */
+static Engine &getEngine()
+{
+    const std::string &name = getConfig().engine;
+
+    if (!engine || (name != engine->getName()))
+        engine.reset(createEngine(name));
+
+    return *engine;
+}
+
+/**
+ * @brief Starts a game and its record.
+ */
+static void startGame(GameModel &model)
+{
+    stopReview();
+
+    startModel(model);
+    initHistory(gameHistory);
+
+    gameRecord.clear();
+    gameRecord.push_back(model);
+}
+
+/**
+ * @brief Plays a move and records it; finished games go to the learner.
+ */
+static void playRecordedMove(GameModel &model, Square move)
+{
+    // Una jugada nueva (tras deshacer) deja obsoleta la revisin
+    stopReview();
+
+    playHistoryMove(model, gameHistory, move);
+
+    gameRecord.push_back(model);
+    if (model.gameOver)
+    {
+        submitGame(gameRecord);
+
+        const Config &config = getConfig();
+        if (config.review)
+            startReview(model, gameHistory, getSearchParams(),
+                        config.reviewDepth, config.reviewTimeMs, config.reviewThreads);
+    }
+}
+
+/**
+ * @brief Starts the AI search of the current position in the background.
+ */
+static void startAISearch(GameModel &model)
+{
+    // La configuracin solo se recarga entre jugadas
+    updateConfig();
+
+    aiThinking = true;
+    aiStartTime = std::chrono::steady_clock::now();
+
+    if (getConfig().searchSliceUs > 0)
+    {
+        aiSlicedParams = getSearchParams();
+        aiSlicedSearch = startSlicedSearch(model, aiSlicedParams, getDefaultSearchLimits(),
+                                           nullptr, &aiSearchInfo);
+        return;
+    }
+
+    Engine &aiEngine = getEngine();
+    aiEngine.setInfoChannel(&aiSearchInfo);
+    aiEngine.setPosition(model);
+
+    aiDone.store(false, std::memory_order_relaxed);
+
+    aiThread = std::thread([&aiEngine]()
+                           {
+                               setTraceThreadName("ai");
+                               aiResult = aiEngine.search(getDefaultSearchLimits());
+                               aiDone.store(true, std::memory_order_release); });
+}
+
+/**
+ * @brief Plays the AI move once its search finished.
+ */
+static void finishAISearch(GameModel &model)
+{
+    const char *mode;
+
+    if (aiSlicedSearch)
+    {
+        // Avanza la bsqueda durante su porcin del cuadro
+        if (!runSlicedSearch(aiSlicedSearch, getConfig().searchSliceUs))
+            return;
+
+        endSlicedSearch(aiSlicedSearch, &aiResult);
+        aiSlicedSearch = nullptr;
+        mode = "sliced";
+    }
+    else
+    {
+        if (!aiDone.load(std::memory_order_acquire))
+            return;
+
+        aiThread.join();
+        mode = engine->getName();
+    }
+
+    aiThinking = false;
+
+    recordMoveLatency(mode, model,
+                      std::chrono::duration<double>(std::chrono::steady_clock::now() - aiStartTime).count(),
+                      aiResult.nodes,
+                      aiResult.depth);
+
+    Square square = aiResult.bestMove;
+
+    // Sin jugada (p. ej. fuera del libro): primera jugada vlida
+    if (!isSquareValid(square))
+    {
+        Moves validMoves;
+        getValidMoves(model, validMoves);
+        square = validMoves[0];
+    }
+
+    playRecordedMove(model, square);
+}
+
+/**
+ * @brief Stops and waits for the AI search, discarding its move.
+ */
+static void stopAISearch()
+{
+    if (!aiThinking)
+        return;
+
+    if (aiSlicedSearch)
+    {
+        endSlicedSearch(aiSlicedSearch, nullptr);
+        aiSlicedSearch = nullptr;
+    }
+    else
+    {
+        engine->stop();
+        aiThread.join();
+    }
+
+    aiThinking = false;
+}
+
+/**
+ * @brief Indicates whether hints are on (configuration, toggled with H).
+ */
+static bool areHintsEnabled()
+{
+    return (getConfig().hints != 0) != hintsToggled;
+}
+
+/**
+ * @brief Starts scoring the human's moves in the background.
+ */
+static void startHints(GameModel &model)
+{
+    hintPosition = model;
+    hintStop.store(false, std::memory_order_relaxed);
+    hintRunning = true;
+
+    // Copia: la configuracin puede recargarse mientras corre
+    SearchParams params = getSearchParams();
+
+    hintThread = std::thread([params]()
+                             {
+                                 lowerCurrentThreadPriority();
+                                 setTraceThreadName("hints");
+
+                                 SearchLimits limits = getDefaultSearchLimits();
+                                 limits.infinite = true;
+                                 limits.multiPV = HINT_MULTI_PV;
+
+                                 SearchResult result;
+                                 searchPosition(hintPosition, params, limits, &hintStop, result,
+                                                &hintSearchInfo); });
+}
+
+/**
+ * @brief Stops and waits for the hint search.
+ */
+static void stopHints()
+{
+    if (!hintRunning)
+        return;
+
+    hintStop.store(true, std::memory_order_relaxed);
+    hintThread.join();
+    hintRunning = false;
+}
+
+/**
+ * @brief Starts the infinite analysis of the current position.
+ */
+static void startAnalysis(GameModel &model)
+{
+    // El editor pausa la partida (gameOver), pero la posicin se analiza
+    analysisPosition = model;
+    analysisPosition.gameOver = false;
+    analysisStop.store(false, std::memory_order_relaxed);
+    analysisRunning = true;
+
+    SearchParams params = getSearchParams();
+
+    analysisThread = std::thread([params]()
+                                 {
+                                     setTraceThreadName("analysis");
+
+                                     SearchLimits limits = getDefaultSearchLimits();
+                                     limits.infinite = true;
+
+                                     SearchResult result;
+                                     searchPosition(analysisPosition, params, limits, &analysisStop, result,
+                                                    &analysisSearchInfo); });
+}
+
+/**
+ * @brief Stops and waits for the analysis.
+ */
+static void stopAnalysis()
+{
+    if (!analysisRunning)
+        return;
+
+    analysisStop.store(true, std::memory_order_relaxed);
+    analysisThread.join();
+    analysisRunning = false;
+}
+
+/**
+ * @brief Keeps the analysis on the position shown, except while the AI
+ * thinks. A position one move away reuses the previous search through the
+ * transposition table.
+ */
+static void updateAnalysis(GameModel &model)
+{
+    if (!analysisEnabled || aiThinking)
+    {
+        stopAnalysis();
+        return;
+    }
+
+    if (analysisRunning && (analysisPosition.version == model.version))
+        return;
+
+    stopAnalysis();
+    startAnalysis(model);
+}
+
+/**
+ * @brief Enters the position editor: the game is paused.
+ */
+static void startEditing(GameModel &model)
+{
+    stopHints();
+    stopAISearch();
+
+    editing = true;
+    model.gameOver = true;
+    setEditMode(true);
+}
+
+/**
+ * @brief Leaves the position editor, starting a game from the position.
+ */
+static void stopEditing(GameModel &model)
+{
+    stopReview();
+
+    editing = false;
+    setEditMode(false);
+
+    startModelFromPosition(model);
+    initHistory(gameHistory);
+
+    gameRecord.clear();
+    gameRecord.push_back(model);
+}
+
+/**
+ * @brief Edits the position: left click places a disc or swaps its color,
+ * right click removes it; B and W choose the player to move; Ctrl+C and
+ * Ctrl+V copy and paste the position string.
+ */
+static void updateEditor(GameModel &model)
+{
+    Square square = getSquareOnMousePointer();
+
+    if (isSquareValid(square))
+    {
+        Piece piece = getBoardPiece(model, square);
+
+        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+            setBoardPiece(model, square, (piece == PIECE_BLACK) ? PIECE_WHITE : PIECE_BLACK);
+        else if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) && (piece != PIECE_EMPTY))
+            setBoardPiece(model, square, PIECE_EMPTY);
+    }
+
+    Player player = model.currentPlayer;
+    if (IsKeyPressed(KEY_B))
+        player = PLAYER_BLACK;
+    if (IsKeyPressed(KEY_W))
+        player = PLAYER_WHITE;
+    if (player != model.currentPlayer)
+    {
+        model.currentPlayer = player;
+        model.version++;
+    }
+
+    if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL))
+    {
+        if (IsKeyPressed(KEY_C))
+        {
+            char position[POSITION_STRING_SIZE];
+
+            getPositionString(model, position);
+            SetClipboardText(position);
+        }
+
+        // Un texto invlido se ignora
+        const char *clipboard;
+        if (IsKeyPressed(KEY_V) && (clipboard = GetClipboardText()))
+            setPositionString(model, clipboard);
+    }
+}
+
+/**
+ * @brief Goes to a ply of the game, keeping the learner's record in step.
+ */
+static void goToPly(GameModel &model, int ply)
+{
+    // Las bsquedas en curso pertenecen a la posicin que se deja
+    stopHints();
+    stopAISearch();
+
+    while ((gameHistory.ply > ply) && undoHistoryMove(model, gameHistory))
+        gameRecord.pop_back();
+    while ((gameHistory.ply < ply) && redoHistoryMove(model, gameHistory))
+        gameRecord.push_back(model);
+}
+
+/**
+ * @brief Takes back moves up to the human's previous turn.
+ */
+static void undoMove(GameModel &model)
+{
+    int ply = gameHistory.ply;
+
+    while (ply > 0)
+    {
+        ply--;
+        if (gameHistory.moves[ply].player == model.humanPlayer)
+            break;
+    }
+
+    goToPly(model, ply);
+}
+
+/**
+ * @brief Redoes moves up to the human's next turn (or the end).
+ */
+static void redoMove(GameModel &model)
+{
+    int ply = gameHistory.ply;
+
+    while (ply < (int)gameHistory.moves.size())
+    {
+        const HistoryMove &record = gameHistory.moves[ply++];
+        if (record.gameOver || (record.nextPlayer == model.humanPlayer))
+            break;
+    }
+
+    goToPly(model, ply);
+}
+
+/**
+ * @brief Starts or stops tracing (F8); stopping writes the trace file.
+ */
+static void toggleTracing()
+{
+    if (isTracing())
+        stopTracing(getConfig().traceFile.c_str());
+    else
+        startTracing();
+}
+
+bool updateSpectatorView()
+{
+    TraceScope trace(TRACE_FRAME, 0);
+
+    if (WindowShouldClose())
+        return false;
+
+    if (IsKeyPressed(KEY_F3))
+        toggleDebugOverlay();
+    if (IsKeyPressed(KEY_F8))
+        toggleTracing();
+
+    // Se dibuja a lo sumo un cuadro por FRAME_TIME, sin importar las partidas
+    if (readSpectatorBoards())
+        drawSpectatorView();
+    else
+        waitSpectatorView();
+
+    return true;
+}
+
 bool updateView(GameModel &model)
 {
+    TraceScope trace(TRACE_FRAME, (int)model.version);
+
     if (WindowShouldClose())
+    {
+        stopReview();
+        stopAnalysis();
+        stopHints();
+        stopAISearch();
+
         return false;
+    }
 
-    if (model.gameOver)
+    if (IsKeyPressed(KEY_F2))
+    {
+        if (editing)
+            stopEditing(model);
+        else
+            startEditing(model);
+    }
+
+    if (editing)
+        updateEditor(model);
+    else if (model.gameOver)
     {
         if (IsMouseButtonPressed(0))
         {
+            stopHints();
+
             if (isMousePointerOverPlayBlackButton())
             {
                 model.humanPlayer = PLAYER_BLACK;
 
-                startModel(model);
+                startGame(model);
             }
             else if (isMousePointerOverPlayWhiteButton())
             {
                 model.humanPlayer = PLAYER_WHITE;
 
-                startModel(model);
+                startGame(model);
             }
         }
     }
     else if (model.currentPlayer == model.humanPlayer)
     {
+        if (!hintRunning && areHintsEnabled())
+            startHints(model);
+
         if (IsMouseButtonPressed(0))
         {
             // Human player
             Square square = getSquareOnMousePointer();
 
-            if (isSquareValid(square))
+            // Play move if valid
+            if (isSquareValid(square) &&
+                (getPositionAnalysis(model).validMoves & SQUARE_BIT(square)))
             {
-                Moves validMoves;
-                getValidMoves(model, validMoves);
-
-                // Play move if valid
-                for (auto move : validMoves)
-                {
-                    if ((square.x == move.x) &&
-                        (square.y == move.y))
-                        playMove(model, square);
-                }
+                // La bsqueda de pistas se cancela antes de jugar; se espera
+                // al hilo despus, sin demorar la jugada
+                hintStop.store(true, std::memory_order_relaxed);
+                playRecordedMove(model, square);
+                stopHints();
             }
         }
     }
     else
     {
         // AI player
-        Square square = getBestMove(model);
+        if (!aiThinking)
+            startAISearch(model);
 
-        playMove(model, square);
+        finishAISearch(model);
     }
 
+    if (IsKeyPressed(KEY_A))
+        analysisEnabled = !analysisEnabled;
+    updateAnalysis(model);
+
+    // Progreso de la IA o del anlisis; el ltimo snapshot de una bsqueda
+    // anterior no se muestra
+    if (aiThinking)
+        aiSearchInfo.update();
+    if (analysisRunning)
+        analysisSearchInfo.update();
+    if (aiThinking && aiSearchInfo.get().searching)
+        setSearchInfo(&aiSearchInfo.get());
+    else if (analysisRunning && analysisSearchInfo.get().searching)
+        setSearchInfo(&analysisSearchInfo.get());
+    else
+        setSearchInfo(nullptr);
+
+    // Revisin de la partida terminada (se ve tambin al navegarla)
+    int reviewTotal = getReviewMoveCount();
+    setReview((reviewTotal && isReviewDone()) ? &getReviewMoves() : nullptr,
+              getReviewProgress(), reviewTotal, gameHistory.ply);
+
+    if (hintRunning)
+        hintSearchInfo.update();
+    setHintInfo((hintRunning && hintSearchInfo.get().searching) ? &hintSearchInfo.get() : nullptr);
+
     if ((IsKeyDown(KEY_LEFT_ALT) ||
          IsKeyDown(KEY_RIGHT_ALT)) &&
         IsKeyPressed(KEY_ENTER))
+    {
         ToggleFullscreen();
+        invalidateView();
+    }
+
+    if (IsKeyPressed(KEY_F3))
+        toggleDebugOverlay();
+    if (IsKeyPressed(KEY_F8))
+        toggleTracing();
+
+    // Historial: deshacer, rehacer, ir al inicio o al final, exportar
+    if (!editing)
+    {
+        if (IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_Z))
+            undoMove(model);
+        if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_Y))
+            redoMove(model);
+        if (IsKeyPressed(KEY_HOME))
+            goToPly(model, 0);
+        if (IsKeyPressed(KEY_END))
+            goToPly(model, (int)gameHistory.moves.size());
+    }
+    if (IsKeyPressed(KEY_E))
+    {
+        saveHistoryTranscript(gameHistory, TRANSCRIPT_FILE);
+        saveReviewReport(REVIEW_FILE);
+    }
 
-    drawView(model);
+    if (IsKeyPressed(KEY_H))
+    {
+        hintsToggled = !hintsToggled;
+        if (!areHintsEnabled())
+            stopHints();
+    }
+
+    // Mientras la IA piensa, sus parmetros no pueden cambiar
+    if (IsKeyPressed(KEY_F5) && !aiThinking)
+        updateConfig(true);
+
+    // Solo se dibuja si algo visible cambi; con una bsqueda por porciones
+    // no se espera: el resto del cuadro es de la bsqueda
+    if (isViewDirty(model))
+        drawView(model);
+    else if (aiSlicedSearch)
+        PollInputEvents();
+    else
+        waitView(model, aiThinking || hintRunning || analysisRunning);
 
     return true;
 }
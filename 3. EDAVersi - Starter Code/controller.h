@@ -18,4 +18,11 @@
  */
 bool updateView(GameModel &model);
 
+/**
+ * @brief Updates the spectator view of a running tournament.
+ *
+ * @return Should the view be closed?
+ */
+bool updateSpectatorView();
+
 #endif
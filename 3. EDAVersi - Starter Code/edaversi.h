@@ -0,0 +1,110 @@
+/**
+ * @brief EDAversi engine C API (stable ABI, no raylib)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ *
+ * Squares are indexed y * 8 + x (0 = a1, 63 = h8). Move sets are 64-bit
+ * masks with bit i set for square i. Scores are from the point of view of
+ * the side to move. Functions returning int return 0 on success and -1 on
+ * error. Different engines may be used from different threads.
+ */
+
+#ifndef EDAVERSI_H
+#define EDAVERSI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(EDAVERSI_BUILD)
+#define EDAVERSI_API __declspec(dllexport)
+#else
+#define EDAVERSI_API __declspec(dllimport)
+#endif
+#else
+#define EDAVERSI_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define EDV_API_VERSION 1
+
+#define EDV_EMPTY 0
+#define EDV_BLACK 1
+#define EDV_WHITE 2
+
+#define EDV_SIDE_BLACK 0
+#define EDV_SIDE_WHITE 1
+
+#define EDV_NO_MOVE (-1)
+
+typedef struct edv_engine edv_engine;
+
+typedef struct edv_position
+{
+    uint8_t board[64];     /* EDV_EMPTY, EDV_BLACK or EDV_WHITE */
+    int32_t side_to_move;  /* EDV_SIDE_BLACK or EDV_SIDE_WHITE; a side with
+                              no legal move passes to the opponent */
+} edv_position;
+
+typedef struct edv_limits
+{
+    int32_t depth;         /* 0: engine default */
+    int32_t move_time_ms;  /* 0: engine default */
+    int64_t max_nodes;     /* 0: engine default */
+    int32_t multi_pv;      /* 0 or 1: best move only */
+} edv_limits;
+
+typedef struct edv_result
+{
+    int32_t best_move;     /* square, or EDV_NO_MOVE */
+    int32_t score;
+    int32_t depth;
+    int64_t nodes;
+    double time;           /* seconds */
+} edv_result;
+
+/* Version */
+EDAVERSI_API uint32_t edv_version(void);
+
+/* Engines: "alphabeta", "solver", "mcts", "book" or "random" */
+EDAVERSI_API edv_engine *edv_create(const char *name);
+EDAVERSI_API void edv_destroy(edv_engine *engine);
+EDAVERSI_API int edv_set_position(edv_engine *engine, const edv_position *position);
+EDAVERSI_API int edv_search(edv_engine *engine, const edv_limits *limits, edv_result *result);
+/* Stops the current search, or the next one if none has started yet;
+   edv_set_position clears a pending stop */
+EDAVERSI_API void edv_stop(edv_engine *engine);
+
+/* Rules */
+EDAVERSI_API void edv_start_position(edv_position *position);
+EDAVERSI_API uint64_t edv_legal_moves(const edv_position *position);
+EDAVERSI_API int edv_make_move(edv_position *position, int32_t square);
+EDAVERSI_API int edv_is_game_over(const edv_position *position);
+
+/* Batched calls: one FFI call for many positions */
+EDAVERSI_API int edv_search_batch(edv_engine *engine,
+                                  const edv_position *positions,
+                                  size_t count,
+                                  const edv_limits *limits,
+                                  edv_result *results);
+EDAVERSI_API void edv_legal_moves_batch(const edv_position *positions,
+                                        size_t count,
+                                        uint64_t *masks);
+EDAVERSI_API void edv_make_move_batch(edv_position *positions,
+                                      const int32_t *squares,
+                                      size_t count,
+                                      int32_t *status);
+EDAVERSI_API void edv_evaluate_batch(const edv_position *positions,
+                                     size_t count,
+                                     int32_t *scores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @brief Implements the pluggable engine interface
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <random>
+
+#include "engine.h"
+#include "solver.h"
+
+const char *const ENGINE_NAMES[] = {
+    ENGINE_ALPHABETA,
+    ENGINE_SOLVER,
+    ENGINE_MCTS,
+    ENGINE_BOOK,
+    ENGINE_RANDOM,
+    nullptr,
+};
+
+// Backends implementados en otros archivos
+Engine *createMCTSEngine();
+Engine *createBookEngine();
+
+Engine::Engine() : stopRequested(false), infoChannel(nullptr)
+{
+    initModel(position);
+
+    stats.searches = 0;
+    stats.nodes = 0;
+    stats.time = 0;
+    stats.allocations = 0;
+    stats.lastDepth = 0;
+    stats.lastNodes = 0;
+    stats.lastTime = 0;
+    stats.lastAllocations = 0;
+}
+
+void Engine::setPosition(const GameModel &model)
+{
+    position = model;
+
+    // Del lado de quien llama: un stop() que llega antes de que el hilo de
+    // bsqueda arranque no se pierde
+    stopRequested.store(false, std::memory_order_relaxed);
+}
+
+void Engine::stop()
+{
+    stopRequested.store(true, std::memory_order_relaxed);
+}
+
+void Engine::setInfoChannel(SearchInfoChannel *channel)
+{
+    infoChannel = channel;
+}
+
+EngineStats Engine::getStats() const
+{
+    return stats;
+}
+
+void Engine::endSearch(const SearchResult &result)
+{
+    stats.searches++;
+    stats.nodes += result.nodes;
+    stats.time += result.time;
+    stats.allocations += result.allocations;
+    stats.lastDepth = result.depth;
+    stats.lastNodes = result.nodes;
+    stats.lastTime = result.time;
+    stats.lastAllocations = result.allocations;
+}
+
+/**
+ * @brief Bsqueda minimax con poda alfa-beta (ai.cpp)
+ */
+class AlphaBetaEngine : public Engine
+{
+public:
+    const char *getName() const
+    {
+        return ENGINE_ALPHABETA;
+    }
+
+    SearchResult search(const SearchLimits &limits)
+    {
+        SearchResult result;
+
+        searchPosition(position, getSearchParams(), limits, &stopRequested, result, infoChannel);
+        endSearch(result);
+
+        return result;
+    }
+};
+
+/**
+ * @brief Resolucin exacta del final; antes, delega en alfa-beta
+ */
+class SolverEngine : public Engine
+{
+public:
+    const char *getName() const
+    {
+        return ENGINE_SOLVER;
+    }
+
+    SearchResult search(const SearchLimits &limits)
+    {
+        SearchResult result;
+        const SearchParams &params = getSearchParams();
+
+        if (countEmptySquares(position) <= params.solverEmpties)
+            solvePosition(position, limits, &stopRequested, result);
+        else
+            searchPosition(position, params, limits, &stopRequested, result, infoChannel);
+        endSearch(result);
+
+        return result;
+    }
+};
+
+/**
+ * @brief Juega una jugada vlida al azar
+ */
+class RandomEngine : public Engine
+{
+public:
+    RandomEngine() : random(std::random_device{}())
+    {
+    }
+
+    const char *getName() const
+    {
+        return ENGINE_RANDOM;
+    }
+
+    SearchResult search(const SearchLimits &)
+    {
+        SearchResult result;
+        result.bestMove = GAME_INVALID_SQUARE;
+        result.score = 0;
+        result.depth = 0;
+        result.nodes = 1;
+        result.time = 0;
+        result.allocations = 0;
+
+        Moves validMoves;
+        if (!position.gameOver)
+            getValidMoves(position, validMoves);
+
+        if (validMoves.size() > 0)
+        {
+            SearchLine line;
+            line.move = validMoves[random() % validMoves.size()];
+            line.score = 0;
+            line.pv.push_back(line.move);
+
+            result.bestMove = line.move;
+            result.lines.push_back(line);
+        }
+
+        endSearch(result);
+
+        return result;
+    }
+
+private:
+    std::mt19937 random;
+};
+
+Engine *createEngine(const std::string &name)
+{
+    if (name == ENGINE_ALPHABETA)
+        return new AlphaBetaEngine();
+    else if (name == ENGINE_SOLVER)
+        return new SolverEngine();
+    else if (name == ENGINE_MCTS)
+        return createMCTSEngine();
+    else if (name == ENGINE_BOOK)
+        return createBookEngine();
+    else if (name == ENGINE_RANDOM)
+        return new RandomEngine();
+
+    return nullptr;
+}
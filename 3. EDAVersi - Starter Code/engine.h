@@ -0,0 +1,123 @@
+/**
+ * @brief Implements the pluggable engine interface
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <atomic>
+#include <string>
+
+#include "ai.h"
+#include "model.h"
+
+#define ENGINE_ALPHABETA "alphabeta"
+#define ENGINE_SOLVER "solver"
+#define ENGINE_MCTS "mcts"
+#define ENGINE_BOOK "book"
+#define ENGINE_RANDOM "random"
+
+/**
+ * @brief Engine names, terminated by nullptr.
+ */
+extern const char *const ENGINE_NAMES[];
+
+/**
+ * @brief Accumulated engine statistics.
+ */
+struct EngineStats
+{
+    long long searches;
+    long long nodes;
+    double time;
+
+    // Heap allocations (ALLOC_TRACKING builds only)
+    long long allocations;
+
+    int lastDepth;
+    long long lastNodes;
+    double lastTime;
+    long long lastAllocations;
+};
+
+/**
+ * @brief A search backend.
+ *
+ * All engines are used the same way: set a position, search it with some
+ * limits (a multiPV limit above one requests that many scored lines), and
+ * read the statistics. stop() may be called from any thread.
+ */
+class Engine
+{
+public:
+    Engine();
+    virtual ~Engine() {}
+
+    /**
+     * @brief Returns the engine name (one of ENGINE_NAMES).
+     */
+    virtual const char *getName() const = 0;
+
+    /**
+     * @brief Sets the position to search and clears any pending stop
+     * request. Call it before every search, from the thread that may
+     * stop it.
+     *
+     * @param model The game model.
+     */
+    virtual void setPosition(const GameModel &model);
+
+    /**
+     * @brief Searches the position.
+     *
+     * bestMove is GAME_INVALID_SQUARE if the engine has no move (no valid
+     * moves, or out of book for the book engine).
+     *
+     * @param limits The search limits.
+     * @return The search result.
+     */
+    virtual SearchResult search(const SearchLimits &limits) = 0;
+
+    /**
+     * @brief Stops the current search as soon as possible. A stop that
+     * arrives before the search starts stops it right away.
+     */
+    void stop();
+
+    /**
+     * @brief Sets a channel that receives progress snapshots while
+     * searching, or nullptr. Engines without iterative progress ignore it.
+     *
+     * @param channel The channel.
+     */
+    void setInfoChannel(SearchInfoChannel *channel);
+
+    /**
+     * @brief Returns the engine statistics.
+     */
+    EngineStats getStats() const;
+
+protected:
+    /**
+     * @brief Updates the statistics; call at the end of a search.
+     */
+    void endSearch(const SearchResult &result);
+
+    GameModel position;
+    std::atomic<bool> stopRequested;
+    SearchInfoChannel *infoChannel;
+    EngineStats stats;
+};
+
+/**
+ * @brief Creates an engine.
+ *
+ * @param name The engine name (one of ENGINE_NAMES).
+ * @return The engine, or nullptr if the name is unknown.
+ */
+Engine *createEngine(const std::string &name);
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * @brief Implements online TD(lambda) learning of the evaluation weights
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "ai.h"
+#include "learn.h"
+#include "metrics.h"
+#include "threads.h"
+
+// Parmetros de TD(lambda)
+#define TD_LEARNING_RATE 10.0F
+#define TD_LAMBDA 0.7F
+#define TD_EVAL_SCALE 200.0F
+
+// Jugadas al azar al comienzo de cada partida de self-play
+#define SELFPLAY_RANDOM_PLIES 4
+
+// Nombres de los pesos en el archivo (mismo orden que EvalFeature)
+static const char *const FEATURE_NAMES[EVAL_FEATURE_COUNT] = {
+    "square0",
+    "square1",
+    "square2",
+    "square3",
+    "square4",
+    "square5",
+    "square6",
+    "square7",
+    "square8",
+    "square9",
+    "mobility",
+    "mobility_block",
+    "mobility_dominance",
+    "edges",
+    "parity",
+    "pieces_early",
+    "pieces_late",
+    "pieces_end",
+};
+
+static bool learnerRunning = false;
+static std::string weightsPath;
+
+static std::thread learnerThread;
+static std::mutex learnerMutex;
+static std::condition_variable learnerCondition;
+static std::deque<GameRecord> pendingGames;
+static bool stopRequested = false;
+
+// Pesos publicados; una versin reemplazada se libera cuando ya ninguna
+// bsqueda la usa (ver isEvalWeightsInUse)
+static std::vector<EvalWeights *> publishedWeights;
+
+/**
+ * @brief Loads weights from a "name = value" file.
+ *
+ * @return true if the file could be read.
+ */
+static bool loadWeights(const char *path, EvalWeights &weights)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file))
+    {
+        char name[64];
+        float value;
+
+        if (line[0] == '#')
+            continue;
+        if (sscanf(line, " %63[^= \t] = %f", name, &value) != 2)
+            continue;
+
+        for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+            if (strcmp(name, FEATURE_NAMES[i]) == 0)
+                weights.weights[i] = value;
+    }
+
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Saves weights to a "name = value" file.
+ */
+static void saveWeights(const char *path, const EvalWeights &weights)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return;
+
+    fprintf(file, "# EDAversi evaluation weights (TD-lambda)\n");
+    for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+        fprintf(file, "%s = %.6g\n", FEATURE_NAMES[i], weights.weights[i]);
+
+    fclose(file);
+}
+
+/**
+ * @brief Publishes a copy of the weights to the search.
+ */
+static void publishWeights(const EvalWeights &weights)
+{
+    EvalWeights *published = new EvalWeights(weights);
+    publishedWeights.push_back(published);
+
+    setEvalWeights(published);
+
+    // Liberar las versiones anteriores que ya no usa ninguna bsqueda
+    size_t kept = 0;
+    for (auto retired : publishedWeights)
+    {
+        if (isEvalWeightsInUse(retired))
+            publishedWeights[kept++] = retired;
+        else
+            delete retired;
+    }
+    publishedWeights.resize(kept);
+}
+
+/**
+ * @brief Returns the predicted result for black (0 = loss, 1 = win).
+ */
+static float predict(const EvalWeights &weights, const float *features)
+{
+    float value = 0;
+    for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+        value += weights.weights[i] * features[i];
+
+    return 1.0F / (1.0F + expf(-value / TD_EVAL_SCALE));
+}
+
+/**
+ * @brief Applies TD(lambda) updates for a finished game.
+ */
+static void learnGame(EvalWeights &weights, GameRecord &record)
+{
+    if (record.size() < 2)
+        return;
+
+    // Resultado final desde el punto de vista de las negras
+    GameModel &last = record.back();
+    int blackScore = getScore(last, PLAYER_BLACK);
+    int whiteScore = getScore(last, PLAYER_WHITE);
+    float outcome = (blackScore > whiteScore)
+                        ? 1.0F
+                        : (blackScore < whiteScore) ? 0.0F : 0.5F;
+
+    float traces[EVAL_FEATURE_COUNT] = {0};
+    float features[EVAL_FEATURE_COUNT];
+
+    getEvalFeatures(record[0], PLAYER_BLACK, features);
+    float value = predict(weights, features);
+
+    for (size_t t = 0; t + 1 < record.size(); t++)
+    {
+        // Trazas de elegibilidad: gradiente de la sigmoide
+        float gradient = value * (1.0F - value) / TD_EVAL_SCALE;
+        for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+            traces[i] = TD_LAMBDA * traces[i] + gradient * features[i];
+
+        float nextValue = outcome;
+        if (t + 2 < record.size())
+        {
+            getEvalFeatures(record[t + 1], PLAYER_BLACK, features);
+            nextValue = predict(weights, features);
+        }
+
+        float delta = nextValue - value;
+        for (int i = 0; i < EVAL_FEATURE_COUNT; i++)
+            weights.weights[i] += TD_LEARNING_RATE * delta * traces[i];
+
+        value = nextValue;
+    }
+}
+
+/**
+ * @brief Learner thread: consumes finished games.
+ */
+static void learnerLoop(EvalWeights weights)
+{
+    lowerCurrentThreadPriority();
+
+    std::unique_lock<std::mutex> lock(learnerMutex);
+
+    while (true)
+    {
+        learnerCondition.wait(lock, []
+                              { return stopRequested || !pendingGames.empty(); });
+
+        if (pendingGames.empty())
+            break;
+
+        GameRecord record;
+        record.swap(pendingGames.front());
+        pendingGames.pop_front();
+        addMetricsQueueDepth(-1);
+
+        lock.unlock();
+        learnGame(weights, record);
+        publishWeights(weights);
+        lock.lock();
+    }
+}
+
+void initLearner(const char *path)
+{
+    if (learnerRunning)
+        return;
+
+    weightsPath = path;
+
+    EvalWeights weights = getDefaultEvalWeights();
+    if (loadWeights(path, weights))
+        publishWeights(weights);
+
+    stopRequested = false;
+    learnerThread = std::thread(learnerLoop, weights);
+    learnerRunning = true;
+}
+
+void freeLearner()
+{
+    if (!learnerRunning)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(learnerMutex);
+        stopRequested = true;
+    }
+    learnerCondition.notify_one();
+    learnerThread.join();
+    learnerRunning = false;
+
+    saveWeights(weightsPath.c_str(), *getEvalWeights());
+
+    setEvalWeights(&getDefaultEvalWeights());
+    for (auto weights : publishedWeights)
+        delete weights;
+    publishedWeights.clear();
+}
+
+void submitGame(const GameRecord &record)
+{
+    if (!learnerRunning)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(learnerMutex);
+        pendingGames.push_back(record);
+    }
+    addMetricsQueueDepth(1);
+    learnerCondition.notify_one();
+}
+
+void runSelfPlay(int games)
+{
+    std::mt19937 random(std::random_device{}());
+
+    for (int i = 0; i < games; i++)
+    {
+        GameModel model;
+        GameRecord record;
+
+        initModel(model);
+        startModel(model);
+        record.push_back(model);
+
+        while (!model.gameOver)
+        {
+            Square move;
+
+            if (record.size() <= SELFPLAY_RANDOM_PLIES)
+            {
+                Moves validMoves;
+                getValidMoves(model, validMoves);
+                move = validMoves[random() % validMoves.size()];
+            }
+            else
+                move = getBestMove(model);
+
+            playMove(model, move);
+            record.push_back(model);
+        }
+
+        submitGame(record);
+    }
+}
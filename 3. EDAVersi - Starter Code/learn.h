@@ -0,0 +1,50 @@
+/**
+ * @brief Implements online TD(lambda) learning of the evaluation weights
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef LEARN_H
+#define LEARN_H
+
+#include <vector>
+
+#include "model.h"
+
+/**
+ * @brief The positions of a game, from the start position to the last one.
+ */
+typedef std::vector<GameModel> GameRecord;
+
+/**
+ * @brief Loads the evaluation weights and starts the background learner.
+ *
+ * @param path The weights file. Missing files are created on exit.
+ */
+void initLearner(const char *path);
+
+/**
+ * @brief Stops the background learner and saves the learned weights.
+ */
+void freeLearner();
+
+/**
+ * @brief Queues a finished game for learning.
+ *
+ * Does nothing if the learner is not running.
+ *
+ * @param record The game record.
+ */
+void submitGame(const GameRecord &record);
+
+/**
+ * @brief Plays AI vs AI games and queues them for learning.
+ *
+ * The first plies are random so that games do not repeat.
+ *
+ * @param games The number of games.
+ */
+void runSelfPlay(int games);
+
+#endif
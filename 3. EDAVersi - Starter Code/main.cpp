@@ -5,12 +5,79 @@
  * @copyright Copyright (c) 2023-2024
  */
 
+#include "config.h"
 #include "model.h"
 #include "view.h"
 #include "controller.h"
+#include "learn.h"
+#include "metrics.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "tournament.h"
+#include "tt.h"
 
-int main()
+int main(int argc, char *argv[])
 {
+    if (!initConfig(argc, argv))
+        return 1;
+
+    const Config &config = getConfig();
+
+    setTraceThreadName("main");
+    if (config.trace)
+        startTracing();
+
+    initTT(config.ttSizeMB);
+
+    // Latencias de las jugadas de la IA en sesiones anteriores
+    initTelemetry(config.telemetryFile.c_str());
+    if (config.latencyReport)
+    {
+        printTelemetry(stdout);
+
+        return 0;
+    }
+
+    // Mtricas en memoria compartida, para edaversi-top
+    if (config.metrics && !startMetrics())
+        printf("could not create the metrics segment\n");
+
+    if (config.learn)
+        initLearner(config.weightsFile.c_str());
+
+    if (config.selfPlayGames > 0)
+    {
+        runSelfPlay(config.selfPlayGames);
+        freeLearner();
+        stopMetrics();
+
+        return 0;
+    }
+
+    // Modo espectador: partidas entre motores en varios tableros
+    if (config.spectateBoards > 0)
+    {
+        initView();
+        startTournament(config.spectateBoards,
+                        config.spectateThreads,
+                        config.matchBlack,
+                        config.matchWhite,
+                        config.matchMoveTimeMs);
+
+        while (updateSpectatorView())
+            ;
+
+        stopTournament();
+        freeView();
+        freeLearner();
+        stopMetrics();
+
+        if (isTracing())
+            stopTracing(config.traceFile.c_str());
+
+        return 0;
+    }
+
     GameModel model;
 
     initModel(model);
@@ -20,4 +87,11 @@ int main()
         ;
 
     freeView();
+
+    saveTelemetry();
+    if (isTracing())
+        stopTracing(config.traceFile.c_str());
+
+    freeLearner();
+    stopMetrics();
 }
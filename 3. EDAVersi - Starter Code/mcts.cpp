@@ -0,0 +1,280 @@
+/**
+ * @brief Implements a Monte Carlo tree search engine (UCT)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "alloc.h"
+#include "engine.h"
+
+// Simulaciones por jugada si no hay lmite de nodos
+#define MCTS_DEFAULT_PLAYOUTS 20000
+
+// Constante de exploracin de UCB1
+#define MCTS_EXPLORATION 1.41421356
+
+// Cada cuntas simulaciones se consulta el reloj
+#define TIME_CHECK_INTERVAL 64
+
+/**
+ * @brief Nodo del rbol; wins es desde el punto de vista de quien jug move
+ */
+struct MCTSNode
+{
+    Square move;
+    Player mover;
+
+    int parent;
+    int firstChild;
+    int childCount;
+
+    int visits;
+    double wins;
+};
+
+class MCTSEngine : public Engine
+{
+public:
+    MCTSEngine() : random(std::random_device{}())
+    {
+    }
+
+    const char *getName() const
+    {
+        return ENGINE_MCTS;
+    }
+
+    SearchResult search(const SearchLimits &limits);
+
+private:
+    int select(int node);
+    void expand(int node, GameModel &model);
+    double playout(GameModel &model, Player mover);
+    int getMostVisitedChild(int node);
+
+    std::vector<MCTSNode> tree;
+    std::mt19937 random;
+};
+
+int MCTSEngine::select(int node)
+{
+    MCTSNode &parent = tree[node];
+    double logVisits = log((double)parent.visits);
+
+    int best = parent.firstChild;
+    double bestValue = -1;
+
+    for (int i = parent.firstChild; i < parent.firstChild + parent.childCount; i++)
+    {
+        MCTSNode &child = tree[i];
+
+        // Primero se prueba cada hijo una vez
+        if (child.visits == 0)
+            return i;
+
+        double value = child.wins / child.visits +
+                       MCTS_EXPLORATION * sqrt(logVisits / child.visits);
+        if (value > bestValue)
+        {
+            bestValue = value;
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+void MCTSEngine::expand(int node, GameModel &model)
+{
+    Moves validMoves;
+    getValidMoves(model, validMoves);
+
+    tree[node].firstChild = (int)tree.size();
+    tree[node].childCount = (int)validMoves.size();
+
+    for (auto move : validMoves)
+    {
+        MCTSNode child;
+        child.move = move;
+        child.mover = model.currentPlayer;
+        child.parent = node;
+        child.firstChild = -1;
+        child.childCount = 0;
+        child.visits = 0;
+        child.wins = 0;
+
+        tree.push_back(child);
+    }
+}
+
+double MCTSEngine::playout(GameModel &model, Player mover)
+{
+    while (!model.gameOver)
+    {
+        Moves validMoves;
+        getValidMoves(model, validMoves);
+
+        playMove(model, validMoves[random() % validMoves.size()]);
+    }
+
+    Player opponent = (mover == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+    int diff = getScore(model, mover) - getScore(model, opponent);
+
+    return (diff > 0) ? 1.0 : (diff < 0) ? 0.0 : 0.5;
+}
+
+int MCTSEngine::getMostVisitedChild(int node)
+{
+    int best = -1;
+
+    for (int i = tree[node].firstChild; i < tree[node].firstChild + tree[node].childCount; i++)
+        if ((best < 0) || (tree[i].visits > tree[best].visits))
+            best = i;
+
+    return best;
+}
+
+SearchResult MCTSEngine::search(const SearchLimits &limits)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    AllocScope allocScope;
+
+    SearchResult result;
+    result.bestMove = GAME_INVALID_SQUARE;
+    result.score = 0;
+    result.depth = 0;
+    result.nodes = 0;
+    result.time = 0;
+    result.allocations = 0;
+
+    const SearchParams &params = getSearchParams();
+    long long maxPlayouts = limits.infinite
+                                ? 0
+                                : (limits.maxNodes ? limits.maxNodes : MCTS_DEFAULT_PLAYOUTS);
+    int moveTimeMs = limits.infinite ? 0 : (limits.moveTimeMs ? limits.moveTimeMs : params.moveTimeMs);
+    std::chrono::steady_clock::time_point deadline = startTime + std::chrono::milliseconds(moveTimeMs);
+
+    tree.clear();
+
+    MCTSNode root;
+    root.move = GAME_INVALID_SQUARE;
+    root.mover = (position.currentPlayer == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+    root.parent = -1;
+    root.firstChild = -1;
+    root.childCount = 0;
+    root.visits = 0;
+    root.wins = 0;
+    tree.push_back(root);
+
+    if (!position.gameOver)
+    {
+        GameModel rootModel = position;
+        expand(0, rootModel);
+    }
+
+    long long playouts = 0;
+
+    while (tree[0].childCount > 0)
+    {
+        if (stopRequested.load(std::memory_order_relaxed))
+            break;
+        if ((maxPlayouts > 0) && (playouts >= maxPlayouts))
+            break;
+        if ((moveTimeMs > 0) && ((playouts % TIME_CHECK_INTERVAL) == 0) &&
+            (std::chrono::steady_clock::now() >= deadline))
+            break;
+
+        // Seleccin
+        GameModel model = position;
+        int node = 0;
+        int depth = 0;
+
+        while (tree[node].childCount > 0)
+        {
+            node = select(node);
+            playMove(model, tree[node].move);
+            depth++;
+
+            if (tree[node].visits == 0)
+                break;
+        }
+
+        // Expansin (al segundo paso por el nodo)
+        if ((tree[node].visits > 0) && !model.gameOver && (tree[node].childCount == 0))
+        {
+            expand(node, model);
+
+            node = tree[node].firstChild;
+            playMove(model, tree[node].move);
+            depth++;
+        }
+
+        result.depth = (depth > result.depth) ? depth : result.depth;
+
+        // Simulacin y propagacin
+        double value = playout(model, tree[node].mover);
+        Player mover = tree[node].mover;
+
+        for (; node >= 0; node = tree[node].parent)
+        {
+            tree[node].visits++;
+            tree[node].wins += (tree[node].mover == mover) ? value : 1.0 - value;
+        }
+
+        playouts++;
+    }
+
+    // Lneas: hijos de la raz por cantidad de visitas
+    std::vector<int> children;
+    for (int i = 0; i < tree[0].childCount; i++)
+        children.push_back(tree[0].firstChild + i);
+
+    std::stable_sort(children.begin(), children.end(),
+                     [this](int a, int b)
+                     { return tree[a].visits > tree[b].visits; });
+
+    int multiPV = (limits.multiPV > 1) ? limits.multiPV : 1;
+    for (int i = 0; (i < (int)children.size()) && (i < multiPV); i++)
+    {
+        MCTSNode &child = tree[children[i]];
+
+        SearchLine line;
+        line.move = child.move;
+        line.score = child.visits ? (int)lround((2 * child.wins / child.visits - 1) * 100) : 0;
+
+        int node = children[i];
+        while ((node >= 0) && (tree[node].visits > 0))
+        {
+            line.pv.push_back(tree[node].move);
+            node = tree[node].childCount ? getMostVisitedChild(node) : -1;
+        }
+
+        result.lines.push_back(line);
+    }
+
+    if (!result.lines.empty())
+    {
+        result.bestMove = result.lines[0].move;
+        result.score = result.lines[0].score;
+    }
+
+    result.nodes = playouts;
+    result.allocations = allocScope.getAllocations();
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    endSearch(result);
+
+    return result;
+}
+
+Engine *createMCTSEngine()
+{
+    return new MCTSEngine();
+}
@@ -0,0 +1,249 @@
+/**
+ * @brief Implements live engine metrics in a shared-memory segment
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "metrics.h"
+#include "tt.h"
+
+// Frecuencia de publicacin
+#define METRICS_INTERVAL_MS 250
+
+/**
+ * @brief The shared segment.
+ *
+ * The sequence is odd while the publisher writes; a reader copies the
+ * values and retries if the sequence changed meanwhile.
+ */
+struct MetricsSegment
+{
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> sequence;
+
+    std::atomic<uint64_t> values[METRICS_FIELD_COUNT];
+};
+
+// Contadores actualizados por el motor
+static std::atomic<long long> nodes;
+static std::atomic<long long> searches;
+static std::atomic<int> searchesInFlight;
+static std::atomic<int> queueDepth;
+static std::atomic<long long> latency[METRICS_PHASE_COUNT][METRICS_LATENCY_STATS];
+
+static MetricsSegment *segment;
+static std::thread publisherThread;
+static std::atomic<bool> publisherStop;
+
+#if defined(_WIN32)
+// Del lector y del publicador
+static HANDLE segmentHandles[2];
+#endif
+
+void addMetricsNodes(long long count)
+{
+    nodes.fetch_add(count, std::memory_order_relaxed);
+}
+
+void beginMetricsSearch()
+{
+    searches.fetch_add(1, std::memory_order_relaxed);
+    searchesInFlight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void endMetricsSearch()
+{
+    searchesInFlight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void addMetricsQueueDepth(int delta)
+{
+    queueDepth.fetch_add(delta, std::memory_order_relaxed);
+}
+
+void setMetricsLatency(int phase, const long long *stats)
+{
+    for (int i = 0; i < METRICS_LATENCY_STATS; i++)
+        latency[phase][i].store(stats[i], std::memory_order_relaxed);
+}
+
+/**
+ * @brief Maps the segment, creating it or opening an existing one.
+ */
+static MetricsSegment *mapSegment(bool create)
+{
+#if defined(_WIN32)
+    HANDLE handle = create
+                        ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+                                             sizeof(MetricsSegment), "Local\\edaversi-metrics")
+                        : OpenFileMappingA(FILE_MAP_READ, FALSE, "Local\\edaversi-metrics");
+    if (!handle)
+        return nullptr;
+
+    void *memory = MapViewOfFile(handle, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ,
+                                 0, 0, sizeof(MetricsSegment));
+    if (!memory)
+    {
+        CloseHandle(handle);
+        return nullptr;
+    }
+
+    segmentHandles[create] = handle;
+#else
+    int fd = create ? shm_open(METRICS_SEGMENT_NAME, O_CREAT | O_RDWR, 0644)
+                    : shm_open(METRICS_SEGMENT_NAME, O_RDONLY, 0);
+    if (fd < 0)
+        return nullptr;
+
+    if (create && (ftruncate(fd, sizeof(MetricsSegment)) != 0))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void *memory = mmap(nullptr, sizeof(MetricsSegment),
+                        create ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                        MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+        return nullptr;
+#endif
+
+    return (MetricsSegment *)memory;
+}
+
+/**
+ * @brief Unmaps the segment; the publisher also removes it.
+ */
+static void unmapSegment(MetricsSegment *memory, bool created)
+{
+#if defined(_WIN32)
+    UnmapViewOfFile(memory);
+    CloseHandle(segmentHandles[created]);
+#else
+    munmap(memory, sizeof(MetricsSegment));
+    if (created)
+        shm_unlink(METRICS_SEGMENT_NAME);
+#endif
+}
+
+/**
+ * @brief Copies the counters to the segment a few times per second.
+ */
+static void runPublisher()
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point lastTime = startTime;
+    long long lastNodes = nodes.load(std::memory_order_relaxed);
+
+    uint64_t values[METRICS_FIELD_COUNT] = {};
+
+#if defined(_WIN32)
+    values[METRICS_PROCESS_ID] = GetCurrentProcessId();
+#else
+    values[METRICS_PROCESS_ID] = (uint64_t)getpid();
+#endif
+
+    while (!publisherStop.load(std::memory_order_relaxed))
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        long long nodeCount = nodes.load(std::memory_order_relaxed);
+        double elapsed = std::chrono::duration<double>(now - lastTime).count();
+
+        values[METRICS_UPTIME_MS] = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
+        values[METRICS_NODES] = (uint64_t)nodeCount;
+        values[METRICS_NODES_PER_SECOND] = (elapsed > 0) ? (uint64_t)((nodeCount - lastNodes) / elapsed) : 0;
+        values[METRICS_SEARCHES] = (uint64_t)searches.load(std::memory_order_relaxed);
+        values[METRICS_SEARCHES_IN_FLIGHT] = (uint64_t)searchesInFlight.load(std::memory_order_relaxed);
+        values[METRICS_TT_FILL] = (uint64_t)getTTFill();
+        values[METRICS_QUEUE_DEPTH] = (uint64_t)queueDepth.load(std::memory_order_relaxed);
+        for (int phase = 0; phase < METRICS_PHASE_COUNT; phase++)
+            for (int i = 0; i < METRICS_LATENCY_STATS; i++)
+                values[METRICS_LATENCY + phase * METRICS_LATENCY_STATS + i] =
+                    (uint64_t)latency[phase][i].load(std::memory_order_relaxed);
+
+        lastTime = now;
+        lastNodes = nodeCount;
+
+        uint32_t sequence = segment->sequence.load(std::memory_order_relaxed);
+
+        segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (int i = 0; i < METRICS_FIELD_COUNT; i++)
+            segment->values[i].store(values[i], std::memory_order_relaxed);
+
+        segment->sequence.store(sequence + 2, std::memory_order_release);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(METRICS_INTERVAL_MS));
+    }
+}
+
+bool startMetrics()
+{
+    segment = mapSegment(true);
+    if (!segment)
+        return false;
+
+    segment->magic = METRICS_MAGIC;
+    segment->version = METRICS_VERSION;
+    segment->sequence.store(0, std::memory_order_relaxed);
+
+    publisherStop.store(false);
+    publisherThread = std::thread(runPublisher);
+
+    return true;
+}
+
+void stopMetrics()
+{
+    if (!segment)
+        return;
+
+    publisherStop.store(true);
+    publisherThread.join();
+
+    unmapSegment(segment, true);
+    segment = nullptr;
+}
+
+bool readMetrics(uint64_t *values)
+{
+    // Se abre en cada lectura: as se sigue a un juego que se reinici
+    MetricsSegment *reader = mapSegment(false);
+    if (!reader)
+        return false;
+
+    bool valid = (reader->magic == METRICS_MAGIC) && (reader->version == METRICS_VERSION);
+    uint32_t sequence = reader->sequence.load(std::memory_order_acquire);
+
+    if (valid && !(sequence & 1))
+    {
+        for (int i = 0; i < METRICS_FIELD_COUNT; i++)
+            values[i] = reader->values[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        valid = (reader->sequence.load(std::memory_order_relaxed) == sequence);
+    }
+    else
+        valid = false;
+
+    unmapSegment(reader, false);
+
+    return valid;
+}
@@ -0,0 +1,104 @@
+/**
+ * @brief Implements live engine metrics in a shared-memory segment
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstdint>
+
+#define METRICS_SEGMENT_NAME "/edaversi-metrics"
+
+// Identifies the segment layout; readers reject other versions
+#define METRICS_MAGIC 0x544d4445
+#define METRICS_VERSION 1
+
+// Latency statistics of a game phase (early, mid, end)
+#define METRICS_PHASE_COUNT 3
+#define METRICS_LATENCY_MOVES 0
+#define METRICS_LATENCY_P50 1
+#define METRICS_LATENCY_P90 2
+#define METRICS_LATENCY_P99 3
+#define METRICS_LATENCY_MAX 4
+#define METRICS_LATENCY_STATS 5
+
+/**
+ * @brief The values published in the segment.
+ */
+enum MetricsField
+{
+    METRICS_PROCESS_ID,
+    METRICS_UPTIME_MS,
+    METRICS_NODES,
+    METRICS_NODES_PER_SECOND,
+    METRICS_SEARCHES,
+    METRICS_SEARCHES_IN_FLIGHT,
+    METRICS_TT_FILL,
+    METRICS_QUEUE_DEPTH,
+
+    // METRICS_LATENCY_STATS values per phase (microseconds)
+    METRICS_LATENCY,
+
+    METRICS_FIELD_COUNT = METRICS_LATENCY + METRICS_PHASE_COUNT * METRICS_LATENCY_STATS,
+};
+
+/**
+ * @brief Adds searched nodes. Safe from any thread.
+ */
+void addMetricsNodes(long long nodes);
+
+/**
+ * @brief Counts a search that starts. Safe from any thread.
+ */
+void beginMetricsSearch();
+
+/**
+ * @brief Counts a search that ends. Safe from any thread.
+ */
+void endMetricsSearch();
+
+/**
+ * @brief Adds to the number of queued jobs (games to learn, positions to
+ * review). Safe from any thread.
+ *
+ * @param delta The change.
+ */
+void addMetricsQueueDepth(int delta);
+
+/**
+ * @brief Sets the move latency of a game phase.
+ *
+ * @param phase The phase (0 to METRICS_PHASE_COUNT - 1).
+ * @param stats METRICS_LATENCY_STATS values (moves, then microseconds).
+ */
+void setMetricsLatency(int phase, const long long *stats);
+
+/**
+ * @brief Creates the shared-memory segment and starts publishing the
+ * metrics a few times per second.
+ *
+ * The engine threads only update counters; a publisher thread copies them
+ * to the segment with a sequence lock, so readers never slow the engine.
+ *
+ * @return true if the segment was created.
+ */
+bool startMetrics();
+
+/**
+ * @brief Stops publishing and removes the segment.
+ */
+void stopMetrics();
+
+/**
+ * @brief Reads the segment of a running game (for the metrics viewer).
+ *
+ * @param values Receives METRICS_FIELD_COUNT values.
+ * @return false if no game publishes metrics, or if the segment was being
+ * written (retry later).
+ */
+bool readMetrics(uint64_t *values);
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @brief Live view of the engine metrics published by a running game
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "metrics.h"
+
+#define DEFAULT_INTERVAL_MS 500
+
+static const char *const PHASE_NAMES[METRICS_PHASE_COUNT] = {"early", "mid", "end"};
+
+static void printUsage()
+{
+    printf("usage: edaversi-top [--interval MS] [--once]\n");
+}
+
+/**
+ * @brief Prints a snapshot of the metrics.
+ */
+static void printMetrics(const uint64_t *values)
+{
+    unsigned long long uptime = values[METRICS_UPTIME_MS] / 1000;
+
+    printf("EDAversi  pid %llu  up %llu:%02llu:%02llu\n\n",
+           (unsigned long long)values[METRICS_PROCESS_ID],
+           uptime / 3600, (uptime / 60) % 60, uptime % 60);
+
+    printf("nodes              %14llu\n", (unsigned long long)values[METRICS_NODES]);
+    printf("nodes/s            %14llu\n", (unsigned long long)values[METRICS_NODES_PER_SECOND]);
+    printf("searches           %14llu\n", (unsigned long long)values[METRICS_SEARCHES]);
+    printf("searches in flight %14llu\n", (unsigned long long)values[METRICS_SEARCHES_IN_FLIGHT]);
+    printf("TT fill            %13.1f%%\n", values[METRICS_TT_FILL] / 10.0);
+    printf("queue depth        %14lld\n", (long long)values[METRICS_QUEUE_DEPTH]);
+
+    printf("\n%-6s %8s %10s %10s %10s %10s\n",
+           "phase", "moves", "p50 ms", "p90 ms", "p99 ms", "max ms");
+    for (int phase = 0; phase < METRICS_PHASE_COUNT; phase++)
+    {
+        const uint64_t *stats = &values[METRICS_LATENCY + phase * METRICS_LATENCY_STATS];
+
+        printf("%-6s %8llu %10.1f %10.1f %10.1f %10.1f\n",
+               PHASE_NAMES[phase],
+               (unsigned long long)stats[METRICS_LATENCY_MOVES],
+               stats[METRICS_LATENCY_P50] / 1000.0,
+               stats[METRICS_LATENCY_P90] / 1000.0,
+               stats[METRICS_LATENCY_P99] / 1000.0,
+               stats[METRICS_LATENCY_MAX] / 1000.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int intervalMs = DEFAULT_INTERVAL_MS;
+    bool once = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((i + 1 < argc) && (strcmp(argv[i], "--interval") == 0))
+            intervalMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--once") == 0)
+            once = true;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    uint64_t values[METRICS_FIELD_COUNT];
+
+    while (true)
+    {
+        // Si el publicador est escribiendo, se reintenta enseguida
+        bool found = false;
+        for (int attempt = 0; (attempt < 100) && !found; attempt++)
+            found = readMetrics(values);
+
+        if (once)
+        {
+            if (found)
+                printMetrics(values);
+            else
+                printf("EDAversi is not running (start it with metrics = 1)\n");
+
+            return found ? 0 : 1;
+        }
+
+        // Borra la pantalla (ANSI)
+        printf("\033[H\033[2J");
+        if (found)
+            printMetrics(values);
+        else
+            printf("waiting for EDAversi (start it with metrics = 1)...\n");
+        fflush(stdout);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+}
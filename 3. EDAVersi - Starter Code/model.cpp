@@ -5,14 +5,34 @@
  * @copyright Copyright (c) 2023-2024
  */
 
-#include "raylib.h"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 
 #include "model.h"
 
+/**
+ * @brief Returns a monotonic time in seconds.
+ *
+ * The model keeps its own clock so that it can run without a window
+ * (e.g. self-play games on a background thread).
+ */
+static double getTime()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void initModel(GameModel &model)
 {
+    model.version = 0;
+
     model.gameOver = true;
 
+    model.currentPlayer = PLAYER_BLACK;
+    model.humanPlayer = PLAYER_BLACK;
+
     model.playerTime[0] = 0;
     model.playerTime[1] = 0;
 
@@ -21,13 +41,15 @@ void initModel(GameModel &model)
 
 void startModel(GameModel &model)
 {
+    model.version++;
+
     model.gameOver = false;
 
     model.currentPlayer = PLAYER_BLACK;
 
     model.playerTime[0] = 0;
     model.playerTime[1] = 0;
-    model.turnTimer = GetTime();
+    model.turnTimer = getTime();
 
     memset(model.board, PIECE_EMPTY, sizeof(model.board));
     model.board[BOARD_SIZE / 2 - 1][BOARD_SIZE / 2 - 1] = PIECE_WHITE;
@@ -36,6 +58,25 @@ void startModel(GameModel &model)
     model.board[BOARD_SIZE / 2][BOARD_SIZE / 2 - 1] = PIECE_BLACK;
 }
 
+void startModelFromPosition(GameModel &model)
+{
+    model.version++;
+
+    model.gameOver = false;
+
+    model.playerTime[0] = 0;
+    model.playerTime[1] = 0;
+    model.turnTimer = getTime();
+
+    // El jugador sin jugadas pasa; si ninguno puede jugar, termin
+    if (getValidMovesMask(model))
+        return;
+
+    model.currentPlayer = (model.currentPlayer == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+    if (!getValidMovesMask(model))
+        model.gameOver = true;
+}
+
 Player getCurrentPlayer(GameModel &model)
 {
     return model.currentPlayer;
@@ -63,7 +104,7 @@ double getTimer(GameModel &model, Player player)
     double turnTime = 0;
 
     if (!model.gameOver && (player == model.currentPlayer))
-        turnTime = GetTime() - model.turnTimer;
+        turnTime = getTime() - model.turnTimer;
 
     return model.playerTime[player] + turnTime;
 }
@@ -76,6 +117,7 @@ Piece getBoardPiece(GameModel &model, Square square)
 void setBoardPiece(GameModel &model, Square square, Piece piece)
 {
     model.board[square.y][square.x] = piece;
+    model.version++;
 }
 
 bool isSquareValid(Square square)
@@ -86,6 +128,111 @@ bool isSquareValid(Square square)
            (square.y < BOARD_SIZE);
 }
 
+void getSquareName(Square square, char *name)
+{
+    name[0] = (char)('a' + square.x);
+    name[1] = (char)('1' + square.y);
+    name[2] = '\0';
+}
+
+Square getSquareFromName(const char *name)
+{
+    Square square = GAME_INVALID_SQUARE;
+
+    if (name[0] && name[1])
+    {
+        char column = (name[0] >= 'A' && name[0] <= 'Z') ? (char)(name[0] - 'A' + 'a') : name[0];
+
+        square.x = column - 'a';
+        square.y = name[1] - '1';
+    }
+
+    if (!isSquareValid(square))
+        return GAME_INVALID_SQUARE;
+
+    return square;
+}
+
+void getPositionString(GameModel &model, char *position)
+{
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+        {
+            Piece piece = model.board[y][x];
+
+            *position++ = (piece == PIECE_BLACK) ? 'X' : (piece == PIECE_WHITE) ? 'O' : '-';
+        }
+
+    *position++ = (model.currentPlayer == PLAYER_WHITE) ? 'O' : 'X';
+    *position = '\0';
+}
+
+/**
+ * @brief Returns the piece of a position string char, or -1 if invalid.
+ */
+static int getPositionPiece(char c)
+{
+    switch (c)
+    {
+    case 'X':
+    case 'x':
+    case '*':
+    case 'B':
+    case 'b':
+        return PIECE_BLACK;
+
+    case 'O':
+    case 'o':
+    case 'W':
+    case 'w':
+        return PIECE_WHITE;
+
+    case '-':
+    case '.':
+    case '_':
+        return PIECE_EMPTY;
+
+    default:
+        return -1;
+    }
+}
+
+bool setPositionString(GameModel &model, const char *position)
+{
+    Piece board[BOARD_SIZE][BOARD_SIZE];
+    Player player = PLAYER_BLACK;
+    int count = 0;
+
+    for (; *position; position++)
+    {
+        if (isspace((unsigned char)*position))
+            continue;
+
+        int piece = getPositionPiece(*position);
+
+        // Tras las casillas, el jugador que mueve (y nada ms)
+        if ((piece < 0) || (count > BOARD_SIZE * BOARD_SIZE) ||
+            ((count == BOARD_SIZE * BOARD_SIZE) && (piece == PIECE_EMPTY)))
+            return false;
+
+        if (count < BOARD_SIZE * BOARD_SIZE)
+            board[count / BOARD_SIZE][count % BOARD_SIZE] = (Piece)piece;
+        else
+            player = (piece == PIECE_WHITE) ? PLAYER_WHITE : PLAYER_BLACK;
+
+        count++;
+    }
+
+    if (count < BOARD_SIZE * BOARD_SIZE)
+        return false;
+
+    memcpy(model.board, board, sizeof(board));
+    model.currentPlayer = player;
+    model.version++;
+
+    return true;
+}
+
 void getValidMoves(GameModel& model, Moves& validMoves)
 {
     // Determinar la ficha del jugador actual y del oponente
@@ -160,7 +307,22 @@ void getValidMoves(GameModel& model, Moves& validMoves)
     }
 }
 
-bool playMove(GameModel &model, Square move)
+uint64_t getValidMovesMask(GameModel &model)
+{
+    uint64_t mask = 0;
+
+    if (model.gameOver)
+        return mask;
+
+    Moves validMoves;
+    getValidMoves(model, validMoves);
+    for (auto move : validMoves)
+        mask |= SQUARE_BIT(move);
+
+    return mask;
+}
+
+bool applyMove(GameModel &model, Square move)
 {
     // Set game piece
     Piece piece =
@@ -235,11 +397,6 @@ bool playMove(GameModel &model, Square move)
         }
     }
 
-    // Update timer
-    double currentTime = GetTime();
-    model.playerTime[model.currentPlayer] += currentTime - model.turnTimer;
-    model.turnTimer = currentTime;
-
     // Swap player
     model.currentPlayer =
         (model.currentPlayer == PLAYER_WHITE)
@@ -267,3 +424,159 @@ bool playMove(GameModel &model, Square move)
 
     return true;
 }
+
+bool playMove(GameModel &model, Square move)
+{
+    // Update timer
+    double currentTime = getTime();
+    model.playerTime[model.currentPlayer] += currentTime - model.turnTimer;
+    model.turnTimer = currentTime;
+
+    return applyMove(model, move);
+}
+
+/**
+ * @brief Returns the squares with a certain piece.
+ */
+static uint64_t getPieceMask(GameModel &model, Piece piece)
+{
+    uint64_t mask = 0;
+
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+            if (model.board[y][x] == piece)
+                mask |= (uint64_t)1 << (y * BOARD_SIZE + x);
+
+    return mask;
+}
+
+/**
+ * @brief Sets the piece of the squares of a mask (one board version).
+ */
+static void setMaskPieces(GameModel &model, uint64_t mask, Piece piece)
+{
+    for (int i = 0; mask; i++, mask >>= 1)
+        if (mask & 1)
+            model.board[i / BOARD_SIZE][i % BOARD_SIZE] = piece;
+
+    model.version++;
+}
+
+static Piece getPlayerPiece(int player)
+{
+    return (player == PLAYER_WHITE) ? PIECE_WHITE : PIECE_BLACK;
+}
+
+void initHistory(GameHistory &history)
+{
+    history.moves.clear();
+    history.ply = 0;
+}
+
+bool playHistoryMove(GameModel &model, GameHistory &history, Square move)
+{
+    HistoryMove record;
+    record.player = (uint8_t)model.currentPlayer;
+
+    Piece piece = getPlayerPiece(record.player);
+    Piece enemyPiece = getPlayerPiece(!record.player);
+    uint64_t enemyDiscs = getPieceMask(model, enemyPiece);
+
+    record.timeBefore[0] = model.playerTime[0];
+    record.timeBefore[1] = model.playerTime[1];
+
+    if (!playMove(model, move))
+        return false;
+
+    record.timeAfter[0] = model.playerTime[0];
+    record.timeAfter[1] = model.playerTime[1];
+
+    // Fichas volteadas: eran del rival y ahora son propias
+    record.flipped = enemyDiscs & getPieceMask(model, piece);
+    record.square = (int8_t)(move.y * BOARD_SIZE + move.x);
+    record.nextPlayer = (uint8_t)model.currentPlayer;
+    record.gameOver = model.gameOver;
+
+    history.moves.resize(history.ply);
+    history.moves.push_back(record);
+    history.ply++;
+
+    return true;
+}
+
+bool undoHistoryMove(GameModel &model, GameHistory &history)
+{
+    if (history.ply == 0)
+        return false;
+
+    const HistoryMove &record = history.moves[--history.ply];
+
+    setMaskPieces(model, (uint64_t)1 << record.square, PIECE_EMPTY);
+    setMaskPieces(model, record.flipped, getPlayerPiece(!record.player));
+
+    model.currentPlayer = (Player)record.player;
+    model.gameOver = false;
+
+    // El tiempo usado en la jugada deshecha no se cobra
+    model.playerTime[0] = record.timeBefore[0];
+    model.playerTime[1] = record.timeBefore[1];
+    model.turnTimer = getTime();
+
+    return true;
+}
+
+bool redoHistoryMove(GameModel &model, GameHistory &history)
+{
+    if (history.ply == (int)history.moves.size())
+        return false;
+
+    const HistoryMove &record = history.moves[history.ply++];
+    Piece piece = getPlayerPiece(record.player);
+
+    setMaskPieces(model, ((uint64_t)1 << record.square) | record.flipped, piece);
+
+    model.currentPlayer = (Player)record.nextPlayer;
+    model.gameOver = record.gameOver;
+
+    model.playerTime[0] = record.timeAfter[0];
+    model.playerTime[1] = record.timeAfter[1];
+    model.turnTimer = getTime();
+
+    return true;
+}
+
+void goToHistoryPly(GameModel &model, GameHistory &history, int ply)
+{
+    while ((history.ply > ply) && undoHistoryMove(model, history))
+        ;
+    while ((history.ply < ply) && redoHistoryMove(model, history))
+        ;
+}
+
+std::string getHistoryTranscript(const GameHistory &history)
+{
+    std::string transcript;
+
+    for (int i = 0; i < history.ply; i++)
+    {
+        int square = history.moves[i].square;
+        char name[3];
+
+        getSquareName({square % BOARD_SIZE, square / BOARD_SIZE}, name);
+        transcript += name;
+    }
+
+    return transcript;
+}
+
+bool saveHistoryTranscript(const GameHistory &history, const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "%s\n", getHistoryTranscript(history).c_str());
+
+    fclose(file);
+    return true;
+}
@@ -9,6 +9,7 @@
 #define MODEL_H
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #define BOARD_SIZE 8
@@ -39,6 +40,9 @@ struct Square
 
 struct GameModel
 {
+    // Incremented on every board change (lets views skip unchanged frames)
+    unsigned int version;
+
     bool gameOver;
 
     Player currentPlayer;
@@ -53,6 +57,45 @@ struct GameModel
 
 typedef std::vector<Square> Moves;
 
+/**
+ * @brief A played move in the history journal: enough to undo or redo it
+ * without replaying the game.
+ */
+struct HistoryMove
+{
+    // Discs flipped by the move (see SQUARE_BIT)
+    uint64_t flipped;
+
+    // Square index (y * BOARD_SIZE + x)
+    int8_t square;
+
+    // Player who moved, player to move after it (passes included) and
+    // whether it ended the game
+    uint8_t player;
+    uint8_t nextPlayer;
+    bool gameOver;
+
+    // Time used by each player before and after the move (see playerTime)
+    double timeBefore[2];
+    double timeAfter[2];
+};
+
+/**
+ * @brief The moves of a game, with the current position in the journal.
+ */
+struct GameHistory
+{
+    std::vector<HistoryMove> moves;
+
+    // Number of moves applied to the model (the rest can be redone)
+    int ply;
+};
+
+/**
+ * @brief Bit of a square in a 64-bit square mask (bit y * 8 + x).
+ */
+#define SQUARE_BIT(square) ((uint64_t)1 << ((square).y * BOARD_SIZE + (square).x))
+
 /**
  * @brief Initializes a game model.
  *
@@ -67,6 +110,15 @@ void initModel(GameModel &model);
  */
 void startModel(GameModel &model);
 
+/**
+ * @brief Starts a game from the position on the board (e.g. an edited
+ * one): resets the timers and passes or ends the game if the player to
+ * move cannot play.
+ *
+ * @param model The game model.
+ */
+void startModelFromPosition(GameModel &model);
+
 /**
  * @brief Returns the model's current player.
  *
@@ -119,6 +171,50 @@ void setBoardPiece(GameModel &model, Square square, Piece piece);
  */
 bool isSquareValid(Square square);
 
+/**
+ * @brief Returns the name of a square ("a1" to "h8").
+ *
+ * @param square The square.
+ * @param name Receives the name (3 chars, including the terminator).
+ */
+void getSquareName(Square square, char *name);
+
+/**
+ * @brief Returns the square with a certain name ("a1" to "h8").
+ *
+ * @param name The name (upper or lower case).
+ * @return The square, or GAME_INVALID_SQUARE.
+ */
+Square getSquareFromName(const char *name);
+
+/**
+ * @brief Size of a position string: one char per square, the player to
+ * move and the terminator.
+ */
+#define POSITION_STRING_SIZE (BOARD_SIZE * BOARD_SIZE + 2)
+
+/**
+ * @brief Returns the position as a string: the squares from a1 to h8, row
+ * by row ('X' black, 'O' white, '-' empty), then the player to move.
+ *
+ * @param model The game model.
+ * @param position Receives the string (POSITION_STRING_SIZE chars).
+ */
+void getPositionString(GameModel &model, char *position);
+
+/**
+ * @brief Sets the board and the player to move from a position string.
+ *
+ * Squares may also be 'x'/'*'/'b' (black), 'o'/'w' (white) or '.'/'_'
+ * (empty); whitespace is skipped. Without a player to move, black moves.
+ * The model is left unchanged if the string is invalid.
+ *
+ * @param model The game model.
+ * @param position The string.
+ * @return true if the string is valid.
+ */
+bool setPositionString(GameModel &model, const char *position);
+
 /**
  * @brief Returns a list of valid moves for the current player.
  *
@@ -127,6 +223,14 @@ bool isSquareValid(Square square);
  */
 void getValidMoves(GameModel &model, Moves &validMoves);
 
+/**
+ * @brief Returns the valid moves for the current player as a square mask.
+ *
+ * @param model The game model.
+ * @return The mask (see SQUARE_BIT), zero if the game is over.
+ */
+uint64_t getValidMovesMask(GameModel &model);
+
 /**
  * @brief Plays a move.
  *
@@ -136,4 +240,78 @@ void getValidMoves(GameModel &model, Moves &validMoves);
  */
 bool playMove(GameModel &model, Square move);
 
+/**
+ * @brief Plays a move like playMove(), without charging the time to the
+ * player clocks (the rules only).
+ *
+ * @param model The game model.
+ * @param square The move.
+ * @return Move accepted.
+ */
+bool applyMove(GameModel &model, Square move);
+
+/**
+ * @brief Clears a history; call after startModel().
+ *
+ * @param history The history.
+ */
+void initHistory(GameHistory &history);
+
+/**
+ * @brief Plays a move and records it, discarding the moves that could be
+ * redone.
+ *
+ * @param model The game model.
+ * @param history The history.
+ * @param move The move.
+ * @return Move accepted.
+ */
+bool playHistoryMove(GameModel &model, GameHistory &history, Square move);
+
+/**
+ * @brief Takes back the last applied move, in constant time. The player
+ * clocks go back to their values before the move.
+ *
+ * @param model The game model.
+ * @param history The history.
+ * @return false if there is no move to take back.
+ */
+bool undoHistoryMove(GameModel &model, GameHistory &history);
+
+/**
+ * @brief Applies again the next taken back move, in constant time. The
+ * player clocks go back to their values after the move.
+ *
+ * @param model The game model.
+ * @param history The history.
+ * @return false if there is no move to redo.
+ */
+bool redoHistoryMove(GameModel &model, GameHistory &history);
+
+/**
+ * @brief Moves to a ply of the history by undoing or redoing moves.
+ *
+ * @param model The game model.
+ * @param history The history.
+ * @param ply The ply (clamped to the recorded moves).
+ */
+void goToHistoryPly(GameModel &model, GameHistory &history, int ply);
+
+/**
+ * @brief Returns the transcript of the applied moves ("f5d6c3...").
+ *
+ * @param history The history.
+ * @return The transcript.
+ */
+std::string getHistoryTranscript(const GameHistory &history);
+
+/**
+ * @brief Saves the transcript of the applied moves to a file.
+ *
+ * @param history The history.
+ * @param path The file path.
+ * @return true on success.
+ */
+bool saveHistoryTranscript(const GameHistory &history, const char *path);
+
 #endif
@@ -0,0 +1,184 @@
+/**
+ * @brief Implements hardware performance counters (Linux perf_event_open)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <cstring>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdint>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "perf.h"
+
+static const char *const COUNTER_NAMES[PERF_COUNTER_COUNT] = {
+    "cycles",
+    "instructions",
+    "cache-misses",
+    "branch-misses",
+    "dtlb-misses",
+};
+
+static int counterFds[PERF_COUNTER_COUNT] = {-1, -1, -1, -1, -1};
+static char counterError[128];
+
+#if defined(__linux__)
+
+/**
+ * @brief Opens one counter; returns its descriptor or -1.
+ */
+static int openCounter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+
+    // Los hilos de bsqueda se crean despus de abrir los contadores
+    attr.inherit = 1;
+
+    // Solo espacio de usuario: permitido con perf_event_paranoid <= 2
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+bool openPerfCounters()
+{
+    static const uint32_t types[PERF_COUNTER_COUNT] = {
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE,
+    };
+    static const uint64_t configs[PERF_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    };
+
+    closePerfCounters();
+
+    bool available = false;
+    int error = 0;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        counterFds[i] = openCounter(types[i], configs[i]);
+        if (counterFds[i] >= 0)
+            available = true;
+        else if (!error)
+            error = errno;
+    }
+
+    if (available)
+        counterError[0] = '\0';
+    else if ((error == EACCES) || (error == EPERM))
+        strcpy(counterError, "no permission (see /proc/sys/kernel/perf_event_paranoid)");
+    else if (error == ENOENT || error == EOPNOTSUPP)
+        strcpy(counterError, "no hardware counters (virtual machine?)");
+    else
+        strncpy(counterError, strerror(error), sizeof(counterError) - 1);
+
+    return available;
+}
+
+void closePerfCounters()
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (counterFds[i] >= 0)
+            close(counterFds[i]);
+        counterFds[i] = -1;
+    }
+}
+
+void startPerfCounters()
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        if (counterFds[i] < 0)
+            continue;
+
+        ioctl(counterFds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counterFds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void stopPerfCounters(PerfCounters &counters)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        counters.values[i] = 0;
+        counters.available[i] = false;
+
+        if (counterFds[i] < 0)
+            continue;
+
+        ioctl(counterFds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        // Valor, tiempo habilitado y tiempo contando
+        uint64_t data[3];
+        if (read(counterFds[i], data, sizeof(data)) != sizeof(data))
+            continue;
+
+        // Con ms eventos que contadores fsicos, el kernel los multiplexa
+        double scale = (data[2] > 0) ? (double)data[1] / data[2] : 0;
+
+        counters.values[i] = (long long)(data[0] * scale);
+        counters.available[i] = (data[2] > 0);
+    }
+}
+
+#else
+
+bool openPerfCounters()
+{
+    strcpy(counterError, "only available on Linux");
+
+    return false;
+}
+
+void closePerfCounters()
+{
+}
+
+void startPerfCounters()
+{
+}
+
+void stopPerfCounters(PerfCounters &counters)
+{
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+        counters.values[i] = 0;
+        counters.available[i] = false;
+    }
+}
+
+#endif
+
+const char *getPerfCountersError()
+{
+    return counterError;
+}
+
+const char *getPerfCounterName(PerfCounter counter)
+{
+    return COUNTER_NAMES[counter];
+}
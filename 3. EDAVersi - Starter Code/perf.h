@@ -0,0 +1,81 @@
+/**
+ * @brief Implements hardware performance counters (Linux perf_event_open)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+/**
+ * @brief The sampled hardware events.
+ */
+enum PerfCounter
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_TLB_MISSES,
+
+    PERF_COUNTER_COUNT
+};
+
+/**
+ * @brief Counter values of a measured region.
+ */
+struct PerfCounters
+{
+    long long values[PERF_COUNTER_COUNT];
+
+    // The counter could be opened (permissions, hardware, OS)
+    bool available[PERF_COUNTER_COUNT];
+};
+
+/**
+ * @brief Opens the counters for the calling thread and the threads it
+ * starts afterwards.
+ *
+ * Counters that cannot be opened (e.g. perf_event_paranoid too high, no
+ * PMU in a VM, not Linux) are marked unavailable; measuring still works.
+ *
+ * @return At least one counter is available.
+ */
+bool openPerfCounters();
+
+/**
+ * @brief Closes the counters.
+ */
+void closePerfCounters();
+
+/**
+ * @brief Returns why no counter could be opened.
+ *
+ * @return The reason, or an empty string.
+ */
+const char *getPerfCountersError();
+
+/**
+ * @brief Resets and enables the counters.
+ */
+void startPerfCounters();
+
+/**
+ * @brief Disables the counters and reads them.
+ *
+ * Values are scaled when the kernel multiplexed a counter.
+ *
+ * @param counters Receives the values.
+ */
+void stopPerfCounters(PerfCounters &counters);
+
+/**
+ * @brief Returns the short name of a counter.
+ *
+ * @param counter The counter.
+ * @return The name.
+ */
+const char *getPerfCounterName(PerfCounter counter);
+
+#endif
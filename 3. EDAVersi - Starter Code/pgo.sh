@@ -0,0 +1,72 @@
+#!/bin/sh
+# Builds a profile-guided optimized release and compares it with the plain
+# optimized (Release + LTO) build on the benchmark.
+#
+# usage: ./pgo.sh [build directory]   (default: _pgo)
+#
+# 1. release/   plain Release build (the baseline)
+# 2. pgo/       instrumented build (PGO=GENERATE), trained on the benchmark
+#               and on self-play games of the tuner
+# 3. pgo/       rebuilt with the profiles (PGO=USE)
+
+set -e
+
+SOURCE_DIR=$(cd "$(dirname "$0")" && pwd)
+BUILD_DIR=${1:-"$SOURCE_DIR/_pgo"}
+PROFILE_DIR="$BUILD_DIR/pgo-data"
+JOBS=$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 2)
+# main only exists when raylib is installed
+TARGETS="bench tuner edaversi"
+
+# Timings are noisy: each build runs the benchmark RUNS times, best kept
+RUNS=${RUNS:-3}
+
+echo "== plain optimized build"
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR/release" -DCMAKE_BUILD_TYPE=Release -DPGO=OFF
+if ! grep -q '^raylib_DIR:PATH=raylib_DIR-NOTFOUND$' "$BUILD_DIR/release/CMakeCache.txt"; then
+    TARGETS="main $TARGETS"
+fi
+cmake --build "$BUILD_DIR/release" -j "$JOBS" --target $TARGETS
+
+echo "== instrumented build"
+rm -rf "$PROFILE_DIR"
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR/pgo" -DCMAKE_BUILD_TYPE=Release -DPGO=GENERATE -DPGO_DIR="$PROFILE_DIR"
+cmake --build "$BUILD_DIR/pgo" -j "$JOBS" --target $TARGETS
+
+echo "== training"
+"$BUILD_DIR/pgo/bench" --no-perf --repeat 200
+rm -f "$BUILD_DIR/pgo/train-params.txt"
+"$BUILD_DIR/pgo/tuner" --iterations 2 --games 8 --movetime 20 --output "$BUILD_DIR/pgo/train-params.txt"
+
+# Clang writes raw profiles that have to be merged
+if ls "$PROFILE_DIR"/*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -output="$PROFILE_DIR/default.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+echo "== optimized build with profiles"
+cmake -S "$SOURCE_DIR" -B "$BUILD_DIR/pgo" -DPGO=USE
+cmake --build "$BUILD_DIR/pgo" -j "$JOBS" --target $TARGETS
+
+echo "== speed (knodes/s, best of $RUNS runs)"
+rm -f "$BUILD_DIR/bench-release.txt" "$BUILD_DIR/bench-pgo.txt"
+for run in $(seq "$RUNS"); do
+    "$BUILD_DIR/release/bench" --no-perf >> "$BUILD_DIR/bench-release.txt"
+    "$BUILD_DIR/pgo/bench" --no-perf >> "$BUILD_DIR/bench-pgo.txt"
+done
+
+awk '$1 ~ /^(validmoves|playmove|evaluate|search)$/ && $3 > 0 {
+         rate = $2 / $3 / 1000
+         if (FNR == NR) {
+             if (rate > release[$1]) release[$1] = rate
+         } else {
+             if (!($1 in pgo)) order[++count] = $1
+             if (rate > pgo[$1]) pgo[$1] = rate
+         }
+     }
+     END {
+         printf "%-12s %10s %10s %8s\n", "benchmark", "release", "pgo", "gain"
+         for (i = 1; i <= count; i++) {
+             name = order[i]
+             printf "%-12s %10.1f %10.1f %+7.1f%%\n", name, release[name], pgo[name], (release[name] > 0) ? (pgo[name] / release[name] - 1) * 100 : 0
+         }
+     }' "$BUILD_DIR/bench-release.txt" "$BUILD_DIR/bench-pgo.txt"
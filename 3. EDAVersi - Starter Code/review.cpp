@@ -0,0 +1,251 @@
+/**
+ * @brief Implements the post-game review of every move, on worker threads
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <thread>
+
+#include "metrics.h"
+#include "review.h"
+#include "threads.h"
+#include "trace.h"
+
+// Todas las jugadas de cada posicin reciben un valor
+#define REVIEW_MULTI_PV (BOARD_SIZE * BOARD_SIZE)
+
+/**
+ * @brief A position to review and the move played in it.
+ */
+struct ReviewTask
+{
+    GameModel position;
+    Square move;
+};
+
+static std::vector<ReviewTask> tasks;
+static std::vector<ReviewMove> reviewMoves;
+
+static std::vector<std::thread> workers;
+static std::atomic<bool> reviewStop;
+
+// Prxima posicin a revisar (de la ltima a la primera) y revisadas
+static std::atomic<int> nextTask;
+static std::atomic<int> finishedTasks;
+
+/**
+ * @brief Searches one position and compares the played move to the best.
+ */
+static void reviewPosition(int index,
+                           const SearchParams &params,
+                           const SearchLimits &limits)
+{
+    ReviewTask &task = tasks[index];
+    ReviewMove &review = reviewMoves[index];
+
+    SearchResult result;
+    searchPosition(task.position, params, limits, &reviewStop, result);
+
+    review.ply = index;
+    review.player = task.position.currentPlayer;
+    review.move = task.move;
+    review.bestMove = result.bestMove;
+    review.bestScore = result.score;
+    review.score = 0;
+    review.loss = 0;
+    review.scored = false;
+    review.depth = result.depth;
+
+    // Solo las lneas de una iteracin completa puntan todas las jugadas;
+    // si se cort la primera, las que faltan no tienen valor
+    Moves validMoves;
+    getValidMoves(task.position, validMoves);
+    if (result.lines.size() < validMoves.size())
+        return;
+
+    for (auto &line : result.lines)
+        if ((line.move.x == task.move.x) && (line.move.y == task.move.y))
+        {
+            review.score = line.score;
+            review.scored = true;
+        }
+
+    if (review.scored)
+        review.loss = std::max(0, review.bestScore - review.score);
+}
+
+static void runWorker(SearchParams params, SearchLimits limits)
+{
+    lowerCurrentThreadPriority();
+    setTraceThreadName("review");
+
+    // Los trabajadores ya reparten las posiciones entre los ncleos
+    params.searchThreads = 1;
+
+    while (!reviewStop.load(std::memory_order_relaxed))
+    {
+        int index = nextTask.fetch_sub(1, std::memory_order_relaxed);
+        if (index < 0)
+            break;
+
+        reviewPosition(index, params, limits);
+
+        finishedTasks.fetch_add(1, std::memory_order_release);
+        addMetricsQueueDepth(-1);
+    }
+}
+
+void startReview(GameModel &model,
+                 const GameHistory &history,
+                 const SearchParams &params,
+                 int depth,
+                 int moveTimeMs,
+                 int threads)
+{
+    stopReview();
+
+    // Se recorre la partida en copias: el modelo no cambia
+    GameModel position = model;
+    GameHistory replay = history;
+    int plies = history.ply;
+
+    goToHistoryPly(position, replay, 0);
+    for (int ply = 0; ply < plies; ply++)
+    {
+        ReviewTask task;
+        task.position = position;
+        task.move.x = replay.moves[ply].square % BOARD_SIZE;
+        task.move.y = replay.moves[ply].square / BOARD_SIZE;
+        tasks.push_back(task);
+
+        redoHistoryMove(position, replay);
+    }
+
+    reviewMoves.resize(tasks.size());
+    if (tasks.empty())
+        return;
+
+    SearchLimits limits = getDefaultSearchLimits();
+    limits.depth = depth;
+    limits.moveTimeMs = moveTimeMs;
+    limits.maxNodes = INT_MAX;
+    limits.multiPV = REVIEW_MULTI_PV;
+
+    if (threads <= 0)
+        threads = std::max(1, (int)std::thread::hardware_concurrency());
+    threads = std::min(threads, (int)tasks.size());
+
+    addMetricsQueueDepth((int)tasks.size());
+
+    reviewStop.store(false);
+    nextTask.store((int)tasks.size() - 1);
+    finishedTasks.store(0);
+    for (int i = 0; i < threads; i++)
+        workers.push_back(std::thread(runWorker, params, limits));
+}
+
+void stopReview()
+{
+    reviewStop.store(true);
+
+    for (auto &worker : workers)
+        worker.join();
+    workers.clear();
+
+    // Posiciones que quedaron sin revisar
+    addMetricsQueueDepth(finishedTasks.load() - (int)tasks.size());
+
+    tasks.clear();
+    reviewMoves.clear();
+    finishedTasks.store(0);
+}
+
+int getReviewMoveCount()
+{
+    return (int)tasks.size();
+}
+
+int getReviewProgress()
+{
+    return finishedTasks.load(std::memory_order_relaxed);
+}
+
+bool isReviewDone()
+{
+    if (tasks.empty() ||
+        (finishedTasks.load(std::memory_order_acquire) < (int)tasks.size()))
+        return false;
+
+    // Los hilos ya terminaron su ltima posicin
+    for (auto &worker : workers)
+        worker.join();
+    workers.clear();
+
+    return true;
+}
+
+const std::vector<ReviewMove> &getReviewMoves()
+{
+    return reviewMoves;
+}
+
+bool saveReviewReport(const char *path)
+{
+    if (!isReviewDone())
+        return false;
+
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    long long totalLoss[2] = {0, 0};
+    int moveCount[2] = {0, 0};
+
+    fprintf(file, "ply,player,move,best,score,best_score,loss,depth\n");
+    for (auto &review : reviewMoves)
+    {
+        char move[3];
+        char bestMove[3] = "--";
+
+        getSquareName(review.move, move);
+        if (isSquareValid(review.bestMove))
+            getSquareName(review.bestMove, bestMove);
+
+        // Sin valor: campos vacos
+        if (!review.scored)
+        {
+            fprintf(file, "%d,%s,%s,%s,,,,%d\n",
+                    review.ply + 1,
+                    (review.player == PLAYER_WHITE) ? "white" : "black",
+                    move,
+                    bestMove,
+                    review.depth);
+            continue;
+        }
+
+        fprintf(file, "%d,%s,%s,%s,%d,%d,%d,%d\n",
+                review.ply + 1,
+                (review.player == PLAYER_WHITE) ? "white" : "black",
+                move,
+                bestMove,
+                review.score,
+                review.bestScore,
+                review.loss,
+                review.depth);
+
+        totalLoss[review.player] += review.loss;
+        moveCount[review.player]++;
+    }
+
+    fprintf(file, "# average loss: black %.1f, white %.1f\n",
+            moveCount[PLAYER_BLACK] ? (double)totalLoss[PLAYER_BLACK] / moveCount[PLAYER_BLACK] : 0.0,
+            moveCount[PLAYER_WHITE] ? (double)totalLoss[PLAYER_WHITE] / moveCount[PLAYER_WHITE] : 0.0);
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,98 @@
+/**
+ * @brief Implements the post-game review of every move, on worker threads
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef REVIEW_H
+#define REVIEW_H
+
+#include <vector>
+
+#include "ai.h"
+#include "model.h"
+
+/**
+ * @brief A reviewed move: the played move against the best one.
+ */
+struct ReviewMove
+{
+    int ply;
+    Player player;
+
+    Square move;
+    Square bestMove;
+
+    // Scores for the player who moved, and the difference (0 or more)
+    int score;
+    int bestScore;
+    int loss;
+
+    // false if a limit cut the search short before it scored the played
+    // move; then score and loss are 0 and the move is left out of the
+    // averages and the chart
+    bool scored;
+
+    // Depth reached by the search
+    int depth;
+};
+
+/**
+ * @brief Starts reviewing the moves of a game on worker threads.
+ *
+ * Every position is searched with all its moves scored (multi-PV), from
+ * the last one toward the first, so that the shared transposition table
+ * already holds the later positions. Stops any previous review.
+ *
+ * @param model The game model, at any ply of the history.
+ * @param history The history (moves up to its current ply are reviewed).
+ * @param params The search parameters.
+ * @param depth The search depth per position.
+ * @param moveTimeMs The time per position (0: depth only).
+ * @param threads The number of worker threads (0: one per core).
+ */
+void startReview(GameModel &model,
+                 const GameHistory &history,
+                 const SearchParams &params,
+                 int depth,
+                 int moveTimeMs,
+                 int threads);
+
+/**
+ * @brief Stops the review, waits for the worker threads and discards it.
+ */
+void stopReview();
+
+/**
+ * @brief Returns the number of moves under review (0: no review).
+ */
+int getReviewMoveCount();
+
+/**
+ * @brief Returns the number of moves reviewed so far.
+ */
+int getReviewProgress();
+
+/**
+ * @brief Indicates whether every move was reviewed (then the results can
+ * be read).
+ */
+bool isReviewDone();
+
+/**
+ * @brief Returns the reviewed moves, in game order. Only valid once
+ * isReviewDone() returns true.
+ */
+const std::vector<ReviewMove> &getReviewMoves();
+
+/**
+ * @brief Saves the finished review as CSV, followed by the average loss of
+ * each player.
+ *
+ * @param path The file path.
+ * @return true on success.
+ */
+bool saveReviewReport(const char *path);
+
+#endif
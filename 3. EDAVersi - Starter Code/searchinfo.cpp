@@ -0,0 +1,56 @@
+/**
+ * @brief Implements the search-info channel from a search thread to the UI
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "searchinfo.h"
+
+// Marca del buffer intermedio: contiene un snapshot an no ledo
+#define SEARCH_INFO_FRESH 4
+
+SearchInfoChannel::SearchInfoChannel() : middle(1), back(2), front(0), sequence(0)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        SearchInfo &info = buffers[i];
+
+        info.sequence = 0;
+        info.searching = false;
+        info.depth = 0;
+        info.nodes = 0;
+        info.time = 0;
+        info.allocations = 0;
+        info.bestMove = GAME_INVALID_SQUARE;
+        info.score = 0;
+        info.pvLength = 0;
+        info.lineCount = 0;
+    }
+}
+
+void SearchInfoChannel::publish(const SearchInfo &info)
+{
+    buffers[back] = info;
+    buffers[back].sequence = ++sequence;
+
+    // El buffer escrito pasa a ser el intermedio; el anterior intermedio
+    // queda libre para la prxima escritura
+    back = middle.exchange(back | SEARCH_INFO_FRESH, std::memory_order_acq_rel) &
+           ~SEARCH_INFO_FRESH;
+}
+
+bool SearchInfoChannel::update()
+{
+    if (!(middle.load(std::memory_order_relaxed) & SEARCH_INFO_FRESH))
+        return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & ~SEARCH_INFO_FRESH;
+
+    return true;
+}
+
+const SearchInfo &SearchInfoChannel::get() const
+{
+    return buffers[front];
+}
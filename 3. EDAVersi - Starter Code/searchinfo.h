@@ -0,0 +1,93 @@
+/**
+ * @brief Implements the search-info channel from a search thread to the UI
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef SEARCHINFO_H
+#define SEARCHINFO_H
+
+#include <atomic>
+
+#include "model.h"
+
+#define SEARCH_INFO_MAX_PV 12
+#define SEARCH_INFO_MAX_LINES 32
+
+// Intervalo mnimo entre publicaciones durante la bsqueda (segundos)
+#define SEARCH_INFO_INTERVAL 0.25
+
+/**
+ * @brief A snapshot of a running search.
+ */
+struct SearchInfo
+{
+    // Increases with every published snapshot
+    unsigned int sequence;
+
+    bool searching;
+
+    int depth;
+    long long nodes;
+    double time;
+
+    // Heap allocations so far (ALLOC_TRACKING builds only)
+    long long allocations;
+
+    // Best move, score and principal variation of the last complete iteration
+    Square bestMove;
+    int score;
+    int pvLength;
+    Square pv[SEARCH_INFO_MAX_PV];
+
+    // Scored root moves of the last complete iteration (multi-PV)
+    int lineCount;
+    Square lineMoves[SEARCH_INFO_MAX_LINES];
+    int lineScores[SEARCH_INFO_MAX_LINES];
+};
+
+/**
+ * @brief Lock-free channel carrying the latest SearchInfo from one writer
+ * thread to one reader thread (triple buffer).
+ *
+ * Neither side ever waits: the writer always has a free buffer and the
+ * reader keeps the last snapshot until a newer one is published.
+ * Intermediate snapshots may be skipped.
+ */
+class SearchInfoChannel
+{
+public:
+    SearchInfoChannel();
+
+    /**
+     * @brief Publishes a snapshot (writer thread).
+     *
+     * @param info The snapshot; its sequence is set by the channel.
+     */
+    void publish(const SearchInfo &info);
+
+    /**
+     * @brief Takes the latest snapshot if there is a new one (reader thread).
+     *
+     * @return true if the snapshot changed.
+     */
+    bool update();
+
+    /**
+     * @brief Returns the current snapshot (reader thread).
+     */
+    const SearchInfo &get() const;
+
+private:
+    SearchInfo buffers[3];
+
+    // ndice del buffer intermedio, con SEARCH_INFO_FRESH si no fue ledo
+    std::atomic<int> middle;
+    int back;
+    int front;
+
+    unsigned int sequence;
+};
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @brief Implements the exact endgame solver
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+#include "alloc.h"
+#include "metrics.h"
+#include "solver.h"
+#include "trace.h"
+
+// Cada cuntos nodos se consulta el reloj
+#define TIME_CHECK_INTERVAL 1024
+
+// Con ms vacas que esto se ordena por movilidad del rival (fastest-first)
+#define FASTEST_FIRST_EMPTIES 6
+
+/**
+ * @brief Estado de una resolucin
+ */
+struct SolverContext
+{
+    long long nodes;
+    long long maxNodes;
+
+    bool hasDeadline;
+    std::chrono::steady_clock::time_point deadline;
+
+    const std::atomic<bool> *stop;
+    bool aborted;
+
+    Square pv[SEARCH_MAX_PLY][SEARCH_MAX_PLY];
+    int pvLength[SEARCH_MAX_PLY];
+};
+
+int countEmptySquares(GameModel &model)
+{
+    int emptySquares = 0;
+
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+            if (model.board[y][x] == PIECE_EMPTY)
+                emptySquares++;
+
+    return emptySquares;
+}
+
+static bool isSolverAborted(SolverContext &context)
+{
+    if (context.aborted)
+        return true;
+
+    if ((context.maxNodes > 0) && (context.nodes >= context.maxNodes))
+        context.aborted = true;
+    else if (context.stop && context.stop->load(std::memory_order_relaxed))
+        context.aborted = true;
+    else if (context.hasDeadline &&
+             ((context.nodes % TIME_CHECK_INTERVAL) == 0) &&
+             (std::chrono::steady_clock::now() >= context.deadline))
+        context.aborted = true;
+
+    return context.aborted;
+}
+
+/**
+ * @brief Simula una jugada sin modificar el modelo original
+ */
+static void makeChild(GameModel &model, Square move, GameModel &child)
+{
+    child = model;
+    playMove(child, move);
+}
+
+/**
+ * @brief Ordena las jugadas: primero las que dejan menos respuestas al rival
+ */
+static void orderFastestFirst(GameModel &model, Moves &moves)
+{
+    std::vector<std::pair<int, int>> keys;
+
+    for (int i = 0; i < (int)moves.size(); i++)
+    {
+        GameModel child;
+        makeChild(model, moves[i], child);
+
+        Moves replies;
+        if (!child.gameOver && (child.currentPlayer != model.currentPlayer))
+            getValidMoves(child, replies);
+
+        keys.push_back(std::make_pair((int)replies.size(), i));
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    Moves ordered;
+    for (auto &key : keys)
+        ordered.push_back(moves[key.second]);
+    moves.swap(ordered);
+}
+
+/**
+ * @brief Negamax con poda alfa-beta sobre la diferencia final de fichas
+ */
+static int solve(SolverContext &context, GameModel &model, int ply, int alpha, int beta)
+{
+    context.nodes++;
+    context.pvLength[ply] = 0;
+
+    if (isSolverAborted(context))
+        return 0;
+
+    Player player = model.currentPlayer;
+    Player opponent = (player == PLAYER_WHITE) ? PLAYER_BLACK : PLAYER_WHITE;
+
+    if (model.gameOver || (ply >= SEARCH_MAX_PLY - 1))
+        return getScore(model, player) - getScore(model, opponent);
+
+    Moves validMoves;
+    getValidMoves(model, validMoves);
+
+    if (countEmptySquares(model) > FASTEST_FIRST_EMPTIES)
+        orderFastestFirst(model, validMoves);
+
+    int best = INT_MIN;
+
+    for (auto move : validMoves)
+    {
+        GameModel child;
+        makeChild(model, move, child);
+
+        // Si el rival pasa, el hijo lo juega el mismo jugador
+        int score = (child.currentPlayer == player)
+                        ? solve(context, child, ply + 1, alpha, beta)
+                        : -solve(context, child, ply + 1, -beta, -alpha);
+
+        if (score > best)
+        {
+            best = score;
+
+            context.pv[ply][0] = move;
+            for (int i = 0; i < context.pvLength[ply + 1]; i++)
+                context.pv[ply][i + 1] = context.pv[ply + 1][i];
+            context.pvLength[ply] = context.pvLength[ply + 1] + 1;
+        }
+
+        alpha = std::max(alpha, score);
+        if (alpha >= beta)
+            break;
+    }
+
+    return best;
+}
+
+void solvePosition(GameModel &model,
+                   const SearchLimits &limits,
+                   const std::atomic<bool> *stop,
+                   SearchResult &result)
+{
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    AllocScope allocScope;
+
+    result.bestMove = GAME_INVALID_SQUARE;
+    result.score = 0;
+    result.depth = 0;
+    result.nodes = 0;
+    result.time = 0;
+    result.allocations = 0;
+    result.lines.clear();
+
+    Moves validMoves;
+    if (!model.gameOver)
+        getValidMoves(model, validMoves);
+
+    if (validMoves.size() == 0)
+        return;
+
+    TraceScope trace(TRACE_SOLVE, countEmptySquares(model));
+    beginMetricsSearch();
+
+    SolverContext context;
+    context.nodes = 0;
+    context.maxNodes = limits.infinite ? 0 : limits.maxNodes;
+    context.hasDeadline = !limits.infinite && (limits.moveTimeMs > 0);
+    context.deadline = startTime + std::chrono::milliseconds(limits.moveTimeMs);
+    context.stop = stop;
+    context.aborted = false;
+
+    int multiPV = std::max(1, std::min(limits.multiPV, (int)validMoves.size()));
+    Player player = model.currentPlayer;
+
+    orderFastestFirst(model, validMoves);
+
+    // Con multi-PV se necesitan valores exactos: sin ventana en la raz
+    int alpha = -BOARD_SIZE * BOARD_SIZE - 1;
+    int beta = BOARD_SIZE * BOARD_SIZE + 1;
+    std::vector<SearchLine> lines;
+
+    for (auto move : validMoves)
+    {
+        GameModel child;
+        makeChild(model, move, child);
+
+        int score = (child.currentPlayer == player)
+                        ? solve(context, child, 1, alpha, beta)
+                        : -solve(context, child, 1, -beta, -alpha);
+
+        if (context.aborted)
+            break;
+
+        SearchLine line;
+        line.move = move;
+        line.score = score;
+        line.pv.assign(1, move);
+        line.pv.insert(line.pv.end(), context.pv[1], context.pv[1] + context.pvLength[1]);
+        lines.push_back(line);
+
+        if (multiPV == 1)
+            alpha = std::max(alpha, score);
+    }
+
+    std::stable_sort(lines.begin(), lines.end(),
+                     [](const SearchLine &a, const SearchLine &b)
+                     { return a.score > b.score; });
+
+    if (lines.size() > (size_t)multiPV)
+        lines.resize(multiPV);
+
+    if (lines.empty())
+        result.bestMove = validMoves[0];
+    else
+    {
+        result.bestMove = lines[0].move;
+        result.score = lines[0].score;
+        result.depth = context.aborted ? 0 : countEmptySquares(model);
+    }
+
+    result.lines = lines;
+    result.nodes = context.nodes;
+
+    addMetricsNodes(context.nodes);
+    endMetricsSearch();
+    result.allocations = allocScope.getAllocations();
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
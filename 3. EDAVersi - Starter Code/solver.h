@@ -0,0 +1,40 @@
+/**
+ * @brief Implements the exact endgame solver
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <atomic>
+
+#include "ai.h"
+#include "model.h"
+
+/**
+ * @brief Returns the number of empty squares.
+ *
+ * @param model The game model.
+ * @return The number of empty squares.
+ */
+int countEmptySquares(GameModel &model);
+
+/**
+ * @brief Solves a position to the end of the game.
+ *
+ * Scores are final disc differences from the point of view of the player
+ * to move. Only the node and time limits are used (zero: no limit).
+ *
+ * @param model The game model.
+ * @param limits The search limits.
+ * @param stop Optional flag that aborts the search when set.
+ * @param result Receives the result.
+ */
+void solvePosition(GameModel &model,
+                   const SearchLimits &limits,
+                   const std::atomic<bool> *stop,
+                   SearchResult &result);
+
+#endif
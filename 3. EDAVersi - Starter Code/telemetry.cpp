@@ -0,0 +1,307 @@
+/**
+ * @brief Implements move-latency telemetry, kept across sessions
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ai.h"
+#include "metrics.h"
+#include "telemetry.h"
+
+// Histograma logartmico en microsegundos: cada potencia de dos se divide
+// en TELEMETRY_SUB_BUCKETS partes (error relativo menor a 1/8)
+#define TELEMETRY_SUB_BUCKETS 8
+#define TELEMETRY_BUCKETS (42 * TELEMETRY_SUB_BUCKETS)
+
+#define TELEMETRY_MODE_SIZE 32
+
+enum GamePhase
+{
+    PHASE_EARLY,
+    PHASE_MID,
+    PHASE_END,
+    PHASE_COUNT,
+};
+
+static const char *const PHASE_NAMES[PHASE_COUNT] = {"early", "mid", "end"};
+
+/**
+ * @brief The latencies of a search mode in a game phase.
+ */
+struct LatencyHistogram
+{
+    char mode[TELEMETRY_MODE_SIZE];
+    int phase;
+
+    long long count;
+    long long maxUs;
+    long long totalNodes;
+    long long totalDepth;
+
+    long long buckets[TELEMETRY_BUCKETS];
+};
+
+static std::vector<LatencyHistogram> histograms;
+static std::string telemetryPath;
+
+/**
+ * @brief Returns the bucket of a latency.
+ */
+static int getBucket(long long us)
+{
+    if (us < TELEMETRY_SUB_BUCKETS)
+        return (int)std::max(0LL, us);
+
+    int shift = 0;
+    while ((us >> shift) >= 2 * TELEMETRY_SUB_BUCKETS)
+        shift++;
+
+    int bucket = (shift + 1) * TELEMETRY_SUB_BUCKETS +
+                 (int)((us >> shift) - TELEMETRY_SUB_BUCKETS);
+
+    return std::min(bucket, TELEMETRY_BUCKETS - 1);
+}
+
+/**
+ * @brief Returns the upper limit of a bucket, in microseconds.
+ */
+static long long getBucketLimit(int bucket)
+{
+    if (bucket < TELEMETRY_SUB_BUCKETS)
+        return bucket + 1;
+
+    int shift = bucket / TELEMETRY_SUB_BUCKETS - 1;
+    long long mantissa = TELEMETRY_SUB_BUCKETS + bucket % TELEMETRY_SUB_BUCKETS;
+
+    return (mantissa + 1) << shift;
+}
+
+/**
+ * @brief Returns the histogram of a mode and phase, creating it if needed.
+ */
+static LatencyHistogram &getHistogram(const char *mode, int phase)
+{
+    for (auto &histogram : histograms)
+        if ((histogram.phase == phase) && !strcmp(histogram.mode, mode))
+            return histogram;
+
+    LatencyHistogram histogram;
+    memset(&histogram, 0, sizeof(histogram));
+    snprintf(histogram.mode, sizeof(histogram.mode), "%s", mode);
+    histogram.phase = phase;
+    histograms.push_back(histogram);
+
+    return histograms.back();
+}
+
+/**
+ * @brief Returns a percentile (0 to 100) of a histogram, in microseconds.
+ *
+ * The upper limit of the bucket is reported (never below the real value),
+ * but never above the maximum.
+ */
+static long long getPercentile(const LatencyHistogram &histogram, double percentile)
+{
+    long long rank = (long long)(histogram.count * percentile / 100 + 0.5);
+    rank = std::max(1LL, std::min(rank, histogram.count));
+
+    long long seen = 0;
+    for (int i = 0; i < TELEMETRY_BUCKETS; i++)
+    {
+        seen += histogram.buckets[i];
+        if (seen >= rank)
+            return std::min(getBucketLimit(i), histogram.maxUs);
+    }
+
+    return histogram.maxUs;
+}
+
+/**
+ * @brief Publishes the latency of a phase (all search modes) to the
+ * live metrics.
+ */
+static void publishLatencyMetrics(int phase)
+{
+    LatencyHistogram total;
+    memset(&total, 0, sizeof(total));
+
+    for (auto &histogram : histograms)
+    {
+        if (histogram.phase != phase)
+            continue;
+
+        total.count += histogram.count;
+        total.maxUs = std::max(total.maxUs, histogram.maxUs);
+        for (int i = 0; i < TELEMETRY_BUCKETS; i++)
+            total.buckets[i] += histogram.buckets[i];
+    }
+
+    if (!total.count)
+        return;
+
+    long long stats[METRICS_LATENCY_STATS];
+    stats[METRICS_LATENCY_MOVES] = total.count;
+    stats[METRICS_LATENCY_P50] = getPercentile(total, 50);
+    stats[METRICS_LATENCY_P90] = getPercentile(total, 90);
+    stats[METRICS_LATENCY_P99] = getPercentile(total, 99);
+    stats[METRICS_LATENCY_MAX] = total.maxUs;
+    setMetricsLatency(phase, stats);
+}
+
+static int getGamePhase(GameModel &model)
+{
+    const SearchParams &params = getSearchParams();
+    int pieces = getScore(model, PLAYER_BLACK) + getScore(model, PLAYER_WHITE);
+
+    if (pieces <= params.earlyGameMaxPieces)
+        return PHASE_EARLY;
+    if (pieces >= params.endGameMinPieces)
+        return PHASE_END;
+
+    return PHASE_MID;
+}
+
+void initTelemetry(const char *path)
+{
+    telemetryPath = path;
+    histograms.clear();
+
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return;
+
+    // Una lnea por histograma: modo, fase, totales y los buckets no vacos
+    // como "bucket:cantidad"
+    char line[8192];
+    while (fgets(line, sizeof(line), file))
+    {
+        char mode[TELEMETRY_MODE_SIZE];
+        char phaseName[16];
+        long long count, maxUs, totalNodes, totalDepth;
+        int length;
+
+        if (line[0] == '#')
+            continue;
+        if (sscanf(line, "%31s %15s %lld %lld %lld %lld%n",
+                   mode, phaseName, &count, &maxUs, &totalNodes, &totalDepth, &length) != 6)
+            continue;
+
+        int phase = -1;
+        for (int i = 0; i < PHASE_COUNT; i++)
+            if (!strcmp(phaseName, PHASE_NAMES[i]))
+                phase = i;
+        if (phase < 0)
+            continue;
+
+        LatencyHistogram &histogram = getHistogram(mode, phase);
+        histogram.count += count;
+        histogram.maxUs = std::max(histogram.maxUs, maxUs);
+        histogram.totalNodes += totalNodes;
+        histogram.totalDepth += totalDepth;
+
+        const char *p = line + length;
+        int bucket;
+        long long bucketCount;
+        while (sscanf(p, " %d:%lld%n", &bucket, &bucketCount, &length) == 2)
+        {
+            if ((bucket >= 0) && (bucket < TELEMETRY_BUCKETS))
+                histogram.buckets[bucket] += bucketCount;
+            p += length;
+        }
+    }
+
+    fclose(file);
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+        publishLatencyMetrics(phase);
+}
+
+void recordMoveLatency(const char *mode,
+                       GameModel &model,
+                       double wallTime,
+                       long long nodes,
+                       int depth)
+{
+    int phase = getGamePhase(model);
+    LatencyHistogram &histogram = getHistogram(mode, phase);
+    long long us = (long long)(wallTime * 1000000);
+
+    histogram.count++;
+    histogram.maxUs = std::max(histogram.maxUs, us);
+    histogram.totalNodes += nodes;
+    histogram.totalDepth += depth;
+    histogram.buckets[getBucket(us)]++;
+
+    publishLatencyMetrics(phase);
+}
+
+bool saveTelemetry()
+{
+    if (telemetryPath.empty())
+        return false;
+
+    FILE *file = fopen(telemetryPath.c_str(), "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "# EDAversi move latency: mode phase moves max_us nodes depth bucket:moves...\n");
+    for (auto &histogram : histograms)
+    {
+        fprintf(file, "%s %s %lld %lld %lld %lld",
+                histogram.mode,
+                PHASE_NAMES[histogram.phase],
+                histogram.count,
+                histogram.maxUs,
+                histogram.totalNodes,
+                histogram.totalDepth);
+
+        for (int i = 0; i < TELEMETRY_BUCKETS; i++)
+            if (histogram.buckets[i])
+                fprintf(file, " %d:%lld", i, histogram.buckets[i]);
+
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return true;
+}
+
+void printTelemetry(FILE *file)
+{
+    if (histograms.empty())
+    {
+        fprintf(file, "no AI moves recorded in %s\n", telemetryPath.c_str());
+        return;
+    }
+
+    // Por modo y luego por fase
+    std::vector<LatencyHistogram *> sorted;
+    for (auto &histogram : histograms)
+        sorted.push_back(&histogram);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const LatencyHistogram *a, const LatencyHistogram *b)
+              {
+                  int compare = strcmp(a->mode, b->mode);
+                  return compare ? (compare < 0) : (a->phase < b->phase);
+              });
+
+    fprintf(file, "%-12s %-6s %8s %10s %10s %10s %10s %12s %6s\n",
+            "mode", "phase", "moves", "p50 ms", "p90 ms", "p99 ms", "max ms", "avg nodes", "depth");
+    for (auto histogram : sorted)
+        fprintf(file, "%-12s %-6s %8lld %10.1f %10.1f %10.1f %10.1f %12lld %6.1f\n",
+                histogram->mode,
+                PHASE_NAMES[histogram->phase],
+                histogram->count,
+                getPercentile(*histogram, 50) / 1000.0,
+                getPercentile(*histogram, 90) / 1000.0,
+                getPercentile(*histogram, 99) / 1000.0,
+                histogram->maxUs / 1000.0,
+                histogram->totalNodes / std::max(1LL, histogram->count),
+                (double)histogram->totalDepth / std::max(1LL, histogram->count));
+}
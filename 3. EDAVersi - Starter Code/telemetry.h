@@ -0,0 +1,56 @@
+/**
+ * @brief Implements move-latency telemetry, kept across sessions
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstdio>
+
+#include "model.h"
+
+/**
+ * @brief Loads the latency histograms of previous sessions.
+ *
+ * @param path The telemetry file. Missing files are created on save.
+ */
+void initTelemetry(const char *path);
+
+/**
+ * @brief Records an AI move. Call from the game loop only.
+ *
+ * Moves are grouped by search mode and by game phase (the phases of the
+ * search depth table).
+ *
+ * @param mode The search mode (engine name, or "sliced").
+ * @param model The position the move was searched from.
+ * @param wallTime The time from the start of the search to the move, in
+ * seconds.
+ * @param nodes The nodes searched.
+ * @param depth The depth reached.
+ */
+void recordMoveLatency(const char *mode,
+                       GameModel &model,
+                       double wallTime,
+                       long long nodes,
+                       int depth);
+
+/**
+ * @brief Saves the histograms to the file given to initTelemetry().
+ *
+ * @return true on success.
+ */
+bool saveTelemetry();
+
+/**
+ * @brief Prints the p50, p90, p99 and max latency, average nodes and
+ * average depth of each search mode and game phase.
+ *
+ * @param file The output file.
+ */
+void printTelemetry(FILE *file);
+
+#endif
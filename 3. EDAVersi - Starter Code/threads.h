@@ -0,0 +1,19 @@
+/**
+ * @brief Implements platform-specific thread helpers
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef THREADS_H
+#define THREADS_H
+
+/**
+ * @brief Lowers the scheduling priority of the calling thread.
+ *
+ * Used by background workers so that they never compete with the game
+ * loop or the search for CPU time.
+ */
+void lowerCurrentThreadPriority();
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * @brief Implements engine-vs-engine matches played by worker threads
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "engine.h"
+#include "tournament.h"
+#include "trace.h"
+
+// Jugadas al azar al comenzar cada partida, para que no se repitan
+#define TOURNAMENT_RANDOM_PLIES 4
+
+/**
+ * @brief A board of the shared game-state table.
+ *
+ * Written by one worker and read by the view with a sequence lock: the
+ * sequence is odd while the worker writes, and the reader retries later
+ * instead of waiting.
+ */
+struct MatchSlot
+{
+    std::atomic<unsigned int> sequence;
+
+    std::atomic<uint64_t> black;
+    std::atomic<uint64_t> white;
+    std::atomic<int> currentPlayer;
+    std::atomic<bool> gameOver;
+    std::atomic<int> lastMove;
+};
+
+/**
+ * @brief Game in progress on a board (owned by its worker).
+ */
+struct MatchGame
+{
+    int slot;
+    GameModel model;
+};
+
+static MatchSlot matchSlots[TOURNAMENT_MAX_BOARDS];
+static int boardCount;
+
+static std::vector<std::thread> workers;
+static std::atomic<bool> tournamentStop;
+
+static std::atomic<int> blackWins;
+static std::atomic<int> whiteWins;
+static std::atomic<int> draws;
+
+/**
+ * @brief Publishes a board to the table.
+ */
+static void publishBoard(MatchSlot &slot, GameModel &model, Square lastMove)
+{
+    uint64_t black = 0;
+    uint64_t white = 0;
+
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+        {
+            Square square = {x, y};
+            Piece piece = getBoardPiece(model, square);
+
+            if (piece == PIECE_BLACK)
+                black |= SQUARE_BIT(square);
+            else if (piece == PIECE_WHITE)
+                white |= SQUARE_BIT(square);
+        }
+
+    unsigned int sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.black.store(black, std::memory_order_relaxed);
+    slot.white.store(white, std::memory_order_relaxed);
+    slot.currentPlayer.store(model.currentPlayer, std::memory_order_relaxed);
+    slot.gameOver.store(model.gameOver, std::memory_order_relaxed);
+    slot.lastMove.store(isSquareValid(lastMove) ? lastMove.y * BOARD_SIZE + lastMove.x : -1,
+                        std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Starts a new game on a board, with a random opening.
+ */
+static void startGame(MatchGame &game, std::mt19937 &random)
+{
+    startModel(game.model);
+
+    for (int i = 0; (i < TOURNAMENT_RANDOM_PLIES) && !game.model.gameOver; i++)
+    {
+        Moves validMoves;
+        getValidMoves(game.model, validMoves);
+        playMove(game.model, validMoves[random() % validMoves.size()]);
+    }
+
+    publishBoard(matchSlots[game.slot], game.model, GAME_INVALID_SQUARE);
+}
+
+/**
+ * @brief Records the result of a finished game.
+ */
+static void recordResult(GameModel &model)
+{
+    int blackScore = getScore(model, PLAYER_BLACK);
+    int whiteScore = getScore(model, PLAYER_WHITE);
+
+    if (blackScore > whiteScore)
+        blackWins++;
+    else if (whiteScore > blackScore)
+        whiteWins++;
+    else
+        draws++;
+}
+
+/**
+ * @brief Plays the moves of the boards slot, slot + step, slot + 2 * step...
+ */
+static void runWorker(int firstSlot,
+                      int step,
+                      std::string blackEngine,
+                      std::string whiteEngine,
+                      int moveTimeMs)
+{
+    setTraceThreadName("match");
+
+    std::mt19937 random(std::random_device{}());
+
+    std::unique_ptr<Engine> engines[2];
+    engines[PLAYER_BLACK].reset(createEngine(blackEngine));
+    engines[PLAYER_WHITE].reset(createEngine(whiteEngine));
+
+    SearchLimits limits = getDefaultSearchLimits();
+    limits.moveTimeMs = moveTimeMs;
+
+    std::vector<MatchGame> games;
+    for (int slot = firstSlot; slot < boardCount; slot += step)
+    {
+        MatchGame game;
+        game.slot = slot;
+        initModel(game.model);
+        games.push_back(game);
+
+        startGame(games.back(), random);
+    }
+
+    // Una jugada por tablero, por turnos, para que todos avancen
+    while (!tournamentStop.load(std::memory_order_relaxed))
+    {
+        for (auto &game : games)
+        {
+            if (tournamentStop.load(std::memory_order_relaxed))
+                break;
+
+            if (game.model.gameOver)
+            {
+                startGame(game, random);
+                continue;
+            }
+
+            Engine &engine = *engines[game.model.currentPlayer];
+            engine.setPosition(game.model);
+            Square move = engine.search(limits).bestMove;
+
+            // Sin jugada (p. ej. fuera del libro): primera jugada vlida
+            if (!isSquareValid(move))
+            {
+                Moves validMoves;
+                getValidMoves(game.model, validMoves);
+                move = validMoves[0];
+            }
+
+            playMove(game.model, move);
+            if (game.model.gameOver)
+                recordResult(game.model);
+
+            publishBoard(matchSlots[game.slot], game.model, move);
+        }
+    }
+}
+
+void startTournament(int boards,
+                     int threads,
+                     const std::string &blackEngine,
+                     const std::string &whiteEngine,
+                     int moveTimeMs)
+{
+    boardCount = std::max(1, std::min(boards, TOURNAMENT_MAX_BOARDS));
+
+    for (int i = 0; i < TOURNAMENT_MAX_BOARDS; i++)
+        matchSlots[i].sequence.store(0, std::memory_order_relaxed);
+
+    if (threads <= 0)
+        threads = std::max(1, (int)std::thread::hardware_concurrency());
+    threads = std::min(threads, boardCount);
+
+    tournamentStop.store(false);
+    for (int i = 0; i < threads; i++)
+        workers.push_back(std::thread(runWorker, i, threads, blackEngine, whiteEngine, moveTimeMs));
+}
+
+void stopTournament()
+{
+    tournamentStop.store(true);
+
+    for (auto &worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+int getTournamentBoardCount()
+{
+    return boardCount;
+}
+
+bool readTournamentBoard(int index, MatchBoard &board)
+{
+    MatchSlot &slot = matchSlots[index];
+
+    unsigned int sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence & 1)
+        return false;
+
+    uint64_t black = slot.black.load(std::memory_order_relaxed);
+    uint64_t white = slot.white.load(std::memory_order_relaxed);
+    int currentPlayer = slot.currentPlayer.load(std::memory_order_relaxed);
+    bool gameOver = slot.gameOver.load(std::memory_order_relaxed);
+    int lastMove = slot.lastMove.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        return false;
+
+    board.sequence = sequence / 2;
+    board.black = black;
+    board.white = white;
+    board.currentPlayer = (Player)currentPlayer;
+    board.gameOver = gameOver;
+    if (lastMove >= 0)
+    {
+        board.lastMove.x = lastMove % BOARD_SIZE;
+        board.lastMove.y = lastMove / BOARD_SIZE;
+    }
+    else
+        board.lastMove = GAME_INVALID_SQUARE;
+
+    return true;
+}
+
+TournamentResults getTournamentResults()
+{
+    TournamentResults results;
+    results.blackWins = blackWins.load(std::memory_order_relaxed);
+    results.whiteWins = whiteWins.load(std::memory_order_relaxed);
+    results.draws = draws.load(std::memory_order_relaxed);
+
+    return results;
+}
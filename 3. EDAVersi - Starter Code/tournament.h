@@ -0,0 +1,89 @@
+/**
+ * @brief Implements engine-vs-engine matches played by worker threads
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <cstdint>
+#include <string>
+
+#include "model.h"
+
+#define TOURNAMENT_MAX_BOARDS 64
+
+/**
+ * @brief A snapshot of one board of the tournament.
+ */
+struct MatchBoard
+{
+    // Increases with every published move (0: no game yet)
+    unsigned int sequence;
+
+    // Discs of each player (see SQUARE_BIT)
+    uint64_t black;
+    uint64_t white;
+
+    Player currentPlayer;
+    bool gameOver;
+
+    // Last move played, or GAME_INVALID_SQUARE
+    Square lastMove;
+};
+
+/**
+ * @brief Accumulated tournament results.
+ */
+struct TournamentResults
+{
+    int blackWins;
+    int whiteWins;
+    int draws;
+};
+
+/**
+ * @brief Starts playing matches on a number of boards.
+ *
+ * Each worker thread plays the moves of its boards in turn, and starts a
+ * new game (with a short random opening) on a board whose game ended.
+ *
+ * @param boards The number of boards (1 to TOURNAMENT_MAX_BOARDS).
+ * @param threads The number of worker threads (0: one per core).
+ * @param blackEngine The engine playing black (one of ENGINE_NAMES).
+ * @param whiteEngine The engine playing white (one of ENGINE_NAMES).
+ * @param moveTimeMs The time limit per move.
+ */
+void startTournament(int boards,
+                     int threads,
+                     const std::string &blackEngine,
+                     const std::string &whiteEngine,
+                     int moveTimeMs);
+
+/**
+ * @brief Stops the matches and waits for the worker threads.
+ */
+void stopTournament();
+
+/**
+ * @brief Returns the number of boards.
+ */
+int getTournamentBoardCount();
+
+/**
+ * @brief Reads a board without ever blocking its worker.
+ *
+ * @param index The board index.
+ * @param board Receives the board; unchanged if the worker was writing it.
+ * @return true if the board was read.
+ */
+bool readTournamentBoard(int index, MatchBoard &board);
+
+/**
+ * @brief Returns the results of the finished games.
+ */
+TournamentResults getTournamentResults();
+
+#endif
@@ -0,0 +1,235 @@
+/**
+ * @brief Implements Chrome trace-event recording of search threads
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "trace.h"
+
+// Eventos por hilo (24 bytes cada uno)
+#define TRACE_BUFFER_EVENTS 16384
+
+static const char *const EVENT_NAMES[TRACE_EVENT_COUNT] = {
+    "iteration",
+    "root move",
+    "solve",
+    "tt resize",
+    "frame",
+};
+
+static const char *const EVENT_CATEGORIES[TRACE_EVENT_COUNT] = {
+    "search",
+    "search",
+    "solver",
+    "tt",
+    "ui",
+};
+
+/**
+ * @brief A ring buffer written by one thread.
+ *
+ * Events are relaxed atomics: the writer never waits, and a reader copies
+ * them and drops the ones that the writer may have overwritten meanwhile.
+ */
+struct TraceBuffer
+{
+    // Eventos escritos desde que se cre el buffer
+    std::atomic<uint64_t> head;
+
+    // Fila de la traza (tid): pasa con el buffer al prximo hilo
+    int id;
+
+    // Tipo (8 bits), hilo (24 bits) y valor (32 bits); inicio y duracin
+    std::atomic<uint64_t> events[TRACE_BUFFER_EVENTS][3];
+};
+
+/**
+ * @brief The buffer of a thread, returned to the pool when it exits.
+ *
+ * Threads come and go (one per search), so their buffers are reused with
+ * their trace ids: the events of an exited thread stay until a new one
+ * fills the ring, and the trace has one row per buffer.
+ */
+struct TraceThread
+{
+    TraceBuffer *buffer;
+    int id;
+    const char *name;
+
+    ~TraceThread();
+};
+
+std::atomic<bool> tracingEnabled;
+
+static std::atomic<int64_t> traceStart;
+
+static std::mutex traceMutex;
+static std::vector<TraceBuffer *> traceBuffers;
+static std::vector<TraceBuffer *> freeBuffers;
+static std::vector<const char *> threadNames;
+
+static thread_local TraceThread traceThread;
+
+TraceThread::~TraceThread()
+{
+    if (!buffer)
+        return;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    freeBuffers.push_back(buffer);
+}
+
+static int64_t getClock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Returns the buffer of the calling thread, taking one on first use.
+ */
+static TraceBuffer *getThreadBuffer()
+{
+    if (traceThread.buffer)
+        return traceThread.buffer;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+
+    if (!freeBuffers.empty())
+    {
+        traceThread.buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+
+        // La fila toma el nombre del hilo nuevo
+        threadNames[traceThread.buffer->id - 1] = traceThread.name;
+    }
+    else
+    {
+        traceThread.buffer = new TraceBuffer();
+        traceBuffers.push_back(traceThread.buffer);
+
+        threadNames.push_back(traceThread.name);
+        traceThread.buffer->id = (int)threadNames.size();
+    }
+
+    traceThread.id = traceThread.buffer->id;
+
+    return traceThread.buffer;
+}
+
+void startTracing()
+{
+    traceStart.store(getClock(), std::memory_order_relaxed);
+    tracingEnabled.store(true, std::memory_order_relaxed);
+}
+
+int64_t getTraceTime()
+{
+    return isTracing() ? getClock() : 0;
+}
+
+void traceEvent(TraceEvent event, int64_t start, int value)
+{
+    if (!start || !isTracing())
+        return;
+
+    int64_t end = getClock();
+    TraceBuffer *buffer = getThreadBuffer();
+
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    std::atomic<uint64_t> *slot = buffer->events[head % TRACE_BUFFER_EVENTS];
+
+    slot[0].store((uint64_t)event | ((uint64_t)(traceThread.id & 0xffffff) << 8) |
+                      ((uint64_t)(uint32_t)value << 32),
+                  std::memory_order_relaxed);
+    slot[1].store((uint64_t)start, std::memory_order_relaxed);
+    slot[2].store((uint64_t)(end - start), std::memory_order_relaxed);
+
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void setTraceThreadName(const char *name)
+{
+    traceThread.name = name;
+
+    // Sin eventos todava: el nombre se registra con el primero
+    if (!traceThread.id)
+        return;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+    threadNames[traceThread.id - 1] = name;
+}
+
+bool stopTracing(const char *path)
+{
+    tracingEnabled.store(false, std::memory_order_relaxed);
+
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    int64_t start = traceStart.load(std::memory_order_relaxed);
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    for (size_t i = 0; i < threadNames.size(); i++)
+    {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                      "\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", (int)i + 1, threadNames[i] ? threadNames[i] : "thread");
+        first = false;
+    }
+
+    for (auto buffer : traceBuffers)
+    {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t oldest = (head > TRACE_BUFFER_EVENTS) ? head - TRACE_BUFFER_EVENTS : 0;
+
+        std::vector<uint64_t> events;
+        for (uint64_t i = oldest; i < head; i++)
+            for (int j = 0; j < 3; j++)
+                events.push_back(buffer->events[i % TRACE_BUFFER_EVENTS][j].load(std::memory_order_relaxed));
+
+        // Un hilo que sigui escribiendo pudo pisar los ms antiguos (y estar
+        // pisando uno ms, an sin publicar)
+        uint64_t newHead = buffer->head.load(std::memory_order_acquire) + 1;
+        uint64_t valid = (newHead > TRACE_BUFFER_EVENTS) ? newHead - TRACE_BUFFER_EVENTS : 0;
+
+        for (uint64_t i = std::max(oldest, valid); i < head; i++)
+        {
+            const uint64_t *event = &events[(i - oldest) * 3];
+            int kind = (int)(event[0] & 0xff);
+            int thread = (int)((event[0] >> 8) & 0xffffff);
+            int value = (int)(int32_t)(uint32_t)(event[0] >> 32);
+            int64_t eventStart = (int64_t)event[1];
+
+            if ((kind >= TRACE_EVENT_COUNT) || (eventStart < start))
+                continue;
+
+            fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                          "\"pid\":1,\"tid\":%d,\"args\":{\"value\":%d}}",
+                    EVENT_NAMES[kind],
+                    EVENT_CATEGORIES[kind],
+                    (eventStart - start) / 1000.0,
+                    (int64_t)event[2] / 1000.0,
+                    thread,
+                    value);
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,98 @@
+/**
+ * @brief Implements Chrome trace-event recording of search threads
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief The kinds of traced events.
+ */
+enum TraceEvent
+{
+    TRACE_ITERATION,
+    TRACE_ROOT_MOVE,
+    TRACE_SOLVE,
+    TRACE_TT_RESIZE,
+    TRACE_FRAME,
+    TRACE_EVENT_COUNT,
+};
+
+/**
+ * @brief Starts recording, dropping the events recorded before.
+ */
+void startTracing();
+
+/**
+ * @brief Stops recording and writes the events to a JSON file that
+ * chrome://tracing and Perfetto can open.
+ *
+ * @param path The file path.
+ * @return true on success.
+ */
+bool stopTracing(const char *path);
+
+/**
+ * @brief Indicates whether events are being recorded.
+ */
+inline bool isTracing()
+{
+    extern std::atomic<bool> tracingEnabled;
+
+    return tracingEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns the current trace time, or 0 if tracing is off.
+ */
+int64_t getTraceTime();
+
+/**
+ * @brief Records a duration event of the calling thread, from start to now.
+ *
+ * Does nothing if start is 0 (tracing was off when the event started).
+ * Each thread writes to its own ring buffer, so the oldest events are
+ * overwritten when it fills up.
+ *
+ * @param event The kind of event.
+ * @param start The start time (see getTraceTime()).
+ * @param value A value shown with the event (depth, move...).
+ */
+void traceEvent(TraceEvent event, int64_t start, int value);
+
+/**
+ * @brief Names the calling thread in the trace.
+ *
+ * @param name The name (a string literal).
+ */
+void setTraceThreadName(const char *name);
+
+/**
+ * @brief Records a duration event for the lifetime of a scope.
+ */
+class TraceScope
+{
+public:
+    TraceScope(TraceEvent event, int value)
+        : event(event), value(value), start(getTraceTime())
+    {
+    }
+
+    ~TraceScope()
+    {
+        traceEvent(event, start, value);
+    }
+
+private:
+    TraceEvent event;
+    int value;
+    int64_t start;
+};
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @brief Implements the transposition table shared by all searches
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+
+#include "trace.h"
+#include "tt.h"
+
+/**
+ * @brief A table slot.
+ *
+ * Without locks: the key is stored XOR-ed with the data, so an entry torn
+ * by two threads writing at once fails the key check and is ignored.
+ */
+struct TTSlot
+{
+    std::atomic<uint64_t> key;
+    std::atomic<uint64_t> data;
+};
+
+/**
+ * @brief Random keys for each square, piece, side to move and point of view.
+ */
+struct ZobristKeys
+{
+    uint64_t pieces[BOARD_SIZE * BOARD_SIZE][2];
+    uint64_t whiteToMove;
+    uint64_t whitePerspective;
+};
+
+static std::unique_ptr<TTSlot[]> slots;
+static uint64_t slotMask;
+static long long slotCount;
+
+static const ZobristKeys &getZobristKeys()
+{
+    struct Generator
+    {
+        ZobristKeys keys;
+
+        Generator()
+        {
+            // Semilla fija: las claves son las mismas en cada ejecucin
+            std::mt19937_64 random(0x45444176657273ULL);
+
+            for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++)
+            {
+                keys.pieces[i][0] = random();
+                keys.pieces[i][1] = random();
+            }
+            keys.whiteToMove = random();
+            keys.whitePerspective = random();
+        }
+    };
+
+    static const Generator generator;
+
+    return generator.keys;
+}
+
+void initTT(int sizeMB)
+{
+    TraceScope trace(TRACE_TT_RESIZE, sizeMB);
+
+    slots.reset();
+    slotMask = 0;
+    slotCount = 0;
+
+    if (sizeMB <= 0)
+        return;
+
+    // Potencia de dos: el ndice es una mscara de la clave
+    long long count = 1;
+    while (count * 2 * (long long)sizeof(TTSlot) <= (long long)sizeMB * 1024 * 1024)
+        count *= 2;
+
+    slots.reset(new TTSlot[count]);
+    slotMask = (uint64_t)count - 1;
+    slotCount = count;
+
+    clearTT();
+}
+
+void clearTT()
+{
+    for (long long i = 0; i < slotCount; i++)
+    {
+        slots[i].key.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool isTTEnabled()
+{
+    return slotCount > 0;
+}
+
+long long getTTEntryCount()
+{
+    return slotCount;
+}
+
+// Entradas revisadas para estimar la ocupacin
+#define TT_FILL_SAMPLE 1000
+
+int getTTFill()
+{
+    long long sample = std::min<long long>(slotCount, TT_FILL_SAMPLE);
+    int used = 0;
+
+    for (long long i = 0; i < sample; i++)
+        if (slots[i].data.load(std::memory_order_relaxed))
+            used++;
+
+    return sample ? (int)(used * 1000 / sample) : 0;
+}
+
+uint64_t getPositionHash(GameModel &model, Player perspective)
+{
+    const ZobristKeys &keys = getZobristKeys();
+    uint64_t hash = 0;
+
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+        {
+            Piece piece = model.board[y][x];
+
+            if (piece != PIECE_EMPTY)
+                hash ^= keys.pieces[y * BOARD_SIZE + x][piece == PIECE_WHITE];
+        }
+
+    if (model.currentPlayer == PLAYER_WHITE)
+        hash ^= keys.whiteToMove;
+    if (perspective == PLAYER_WHITE)
+        hash ^= keys.whitePerspective;
+
+    return hash;
+}
+
+// Datos de una entrada: valor (32 bits), profundidad (8), cota (2) y
+// jugada (7 bits; 0 si no hay)
+#define TT_SCORE_SHIFT 0
+#define TT_DEPTH_SHIFT 32
+#define TT_BOUND_SHIFT 40
+#define TT_MOVE_SHIFT 42
+
+bool probeTT(uint64_t key, TTProbe &probe)
+{
+    if (!slotCount)
+        return false;
+
+    TTSlot &slot = slots[key & slotMask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+
+    if ((slot.key.load(std::memory_order_relaxed) ^ data) != key)
+        return false;
+
+    int move = (int)((data >> TT_MOVE_SHIFT) & 0x7f) - 1;
+
+    probe.score = (int32_t)(uint32_t)(data >> TT_SCORE_SHIFT);
+    probe.depth = (int)((data >> TT_DEPTH_SHIFT) & 0xff);
+    probe.bound = (TTBound)((data >> TT_BOUND_SHIFT) & 0x3);
+    if (move >= 0)
+    {
+        probe.move.x = move % BOARD_SIZE;
+        probe.move.y = move / BOARD_SIZE;
+    }
+    else
+        probe.move = GAME_INVALID_SQUARE;
+
+    return true;
+}
+
+void storeTT(uint64_t key, int depth, int score, TTBound bound, Square move)
+{
+    if (!slotCount)
+        return;
+
+    uint64_t moveIndex = isSquareValid(move) ? (uint64_t)(move.y * BOARD_SIZE + move.x + 1) : 0;
+    uint64_t data = ((uint64_t)(uint32_t)score << TT_SCORE_SHIFT) |
+                    ((uint64_t)(depth & 0xff) << TT_DEPTH_SHIFT) |
+                    ((uint64_t)bound << TT_BOUND_SHIFT) |
+                    (moveIndex << TT_MOVE_SHIFT);
+
+    TTSlot &slot = slots[key & slotMask];
+    slot.key.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
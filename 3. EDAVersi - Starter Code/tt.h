@@ -0,0 +1,97 @@
+/**
+ * @brief Implements the transposition table shared by all searches
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef TT_H
+#define TT_H
+
+#include <cstdint>
+
+#include "model.h"
+
+enum TTBound
+{
+    TT_BOUND_EXACT,
+    TT_BOUND_LOWER,
+    TT_BOUND_UPPER,
+};
+
+/**
+ * @brief A transposition table hit.
+ */
+struct TTProbe
+{
+    int depth;
+    int score;
+    TTBound bound;
+
+    // Best move found, or GAME_INVALID_SQUARE
+    Square move;
+};
+
+/**
+ * @brief Allocates the table, clearing it.
+ *
+ * Must not be called while a search is running.
+ *
+ * @param sizeMB The size in megabytes (0 disables the table).
+ */
+void initTT(int sizeMB);
+
+/**
+ * @brief Clears the table.
+ */
+void clearTT();
+
+/**
+ * @brief Indicates whether the table is allocated.
+ */
+bool isTTEnabled();
+
+/**
+ * @brief Returns the number of entries.
+ */
+long long getTTEntryCount();
+
+/**
+ * @brief Returns the fraction of used entries, in thousandths (sampled).
+ */
+int getTTFill();
+
+/**
+ * @brief Returns the hash key of a position (Zobrist).
+ *
+ * The key includes the side to move and the player whose point of view
+ * the scores are from (evaluations are not zero-sum).
+ *
+ * @param model The game model.
+ * @param perspective The player the scores are for.
+ * @return The key.
+ */
+uint64_t getPositionHash(GameModel &model, Player perspective);
+
+/**
+ * @brief Looks up a position. Safe to call from several threads at once.
+ *
+ * @param key The position key.
+ * @param probe Receives the entry.
+ * @return true if the position was found.
+ */
+bool probeTT(uint64_t key, TTProbe &probe);
+
+/**
+ * @brief Stores a position, replacing the entry in its slot. Safe to
+ * call from several threads at once.
+ *
+ * @param key The position key.
+ * @param depth The remaining depth of the search.
+ * @param score The score.
+ * @param bound Whether the score is exact or a bound.
+ * @param move The best move, or GAME_INVALID_SQUARE.
+ */
+void storeTT(uint64_t key, int depth, int score, TTBound bound, Square move);
+
+#endif
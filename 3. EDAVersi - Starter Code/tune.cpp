@@ -0,0 +1,265 @@
+/**
+ * @brief SPSA tuner for the search parameters (parallel self-play)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ai.h"
+#include "model.h"
+
+#define DEFAULT_ITERATIONS 200
+#define DEFAULT_GAMES 16
+#define DEFAULT_MOVE_TIME_MS 50
+#define DEFAULT_OUTPUT "params.txt"
+
+// Jugadas al azar de cada apertura (compartida por cada par de partidas)
+#define OPENING_RANDOM_PLIES 6
+
+// Ganancias de SPSA, sobre parmetros normalizados a [0, 1]
+#define SPSA_A 0.05
+#define SPSA_C 0.1
+#define SPSA_ALPHA 0.602
+#define SPSA_GAMMA 0.101
+
+/**
+ * @brief A tuned parameter and its tuning range.
+ */
+struct TunedParam
+{
+    const char *name;
+    int minValue;
+    int maxValue;
+};
+
+// Parmetros ajustados
+static const TunedParam TUNED_PARAMS[] = {
+    {"early_game_depth", 1, 12},
+    {"mid_game_depth", 1, 12},
+    {"end_game_depth", 4, 20},
+    {"early_game_max_pieces", 10, 30},
+    {"end_game_min_pieces", 36, 56},
+    {"max_nodes", 10000, 2000000},
+};
+
+#define TUNED_PARAM_COUNT ((int)(sizeof(TUNED_PARAMS) / sizeof(TUNED_PARAMS[0])))
+
+/**
+ * @brief Returns the field of a declared search parameter.
+ */
+static int SearchParams::*findParamField(const char *name)
+{
+    for (int i = 0; i < getSearchParamCount(); i++)
+        if (strcmp(getSearchParamInfo(i).name, name) == 0)
+            return getSearchParamInfo(i).field;
+
+    return nullptr;
+}
+
+/**
+ * @brief Converts normalized values to search parameters.
+ */
+static SearchParams toSearchParams(const SearchParams &base,
+                                   const std::vector<double> &values)
+{
+    SearchParams params = base;
+
+    for (int i = 0; i < TUNED_PARAM_COUNT; i++)
+    {
+        const TunedParam &tuned = TUNED_PARAMS[i];
+        double value = tuned.minValue + values[i] * (tuned.maxValue - tuned.minValue);
+
+        params.*findParamField(tuned.name) = (int)lround(value);
+    }
+
+    return params;
+}
+
+/**
+ * @brief Plays a game and returns black's disc difference.
+ */
+static int playGame(const SearchParams &black,
+                    const SearchParams &white,
+                    unsigned int openingSeed)
+{
+    std::mt19937 random(openingSeed);
+    GameModel model;
+    int ply = 0;
+
+    initModel(model);
+    startModel(model);
+
+    while (!model.gameOver)
+    {
+        Square move;
+
+        if (ply < OPENING_RANDOM_PLIES)
+        {
+            Moves validMoves;
+            getValidMoves(model, validMoves);
+            move = validMoves[random() % validMoves.size()];
+        }
+        else
+            move = getBestMove(model,
+                               (model.currentPlayer == PLAYER_BLACK) ? black : white);
+
+        playMove(model, move);
+        ply++;
+    }
+
+    return getScore(model, PLAYER_BLACK) - getScore(model, PLAYER_WHITE);
+}
+
+/**
+ * @brief Plays a batch of games in parallel, swapping colors on each
+ * opening, and returns the mean result for the first parameters in [-1, 1].
+ */
+static double playMatch(const SearchParams &first,
+                        const SearchParams &second,
+                        int games,
+                        int threads,
+                        unsigned int seed)
+{
+    std::vector<int> results(games);
+    std::atomic<int> nextGame(0);
+
+    auto worker = [&]()
+    {
+        int game;
+        while ((game = nextGame.fetch_add(1)) < games)
+        {
+            unsigned int openingSeed = seed + game / 2;
+            int diff;
+
+            if ((game % 2) == 0)
+                diff = playGame(first, second, openingSeed);
+            else
+                diff = -playGame(second, first, openingSeed);
+
+            results[game] = (diff > 0) - (diff < 0);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+        workers.push_back(std::thread(worker));
+    for (auto &thread : workers)
+        thread.join();
+
+    int total = 0;
+    for (int result : results)
+        total += result;
+
+    return (double)total / games;
+}
+
+static void printUsage()
+{
+    printf("usage: tuner [--iterations N] [--games N] [--threads N]\n"
+           "             [--movetime MS] [--output FILE]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = DEFAULT_ITERATIONS;
+    int games = DEFAULT_GAMES;
+    int threads = (int)std::thread::hardware_concurrency();
+    int moveTimeMs = DEFAULT_MOVE_TIME_MS;
+    const char *output = DEFAULT_OUTPUT;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((i + 1 < argc) && (strcmp(argv[i], "--iterations") == 0))
+            iterations = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--games") == 0))
+            games = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--threads") == 0))
+            threads = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--movetime") == 0))
+            moveTimeMs = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--output") == 0))
+            output = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    threads = std::max(threads, 1);
+    games = std::max(games + (games % 2), 2);
+
+    // Se parte del archivo existente (permite continuar un ajuste)
+    SearchParams base = getDefaultSearchParams();
+    loadSearchParams(output, base);
+
+    // El control de tiempo del ajuste no se guarda: el juego lee el mismo
+    // archivo
+    int savedMoveTimeMs = base.moveTimeMs;
+    base.moveTimeMs = moveTimeMs;
+
+    std::vector<double> values(TUNED_PARAM_COUNT);
+    for (int i = 0; i < TUNED_PARAM_COUNT; i++)
+    {
+        const TunedParam &tuned = TUNED_PARAMS[i];
+        int value = base.*findParamField(tuned.name);
+
+        values[i] = (double)(value - tuned.minValue) / (tuned.maxValue - tuned.minValue);
+        values[i] = std::min(std::max(values[i], 0.0), 1.0);
+    }
+
+    std::mt19937 random(std::random_device{}());
+    double stability = 0.1 * iterations;
+
+    for (int k = 0; k < iterations; k++)
+    {
+        double ak = SPSA_A / pow(k + 1 + stability, SPSA_ALPHA);
+        double ck = SPSA_C / pow(k + 1, SPSA_GAMMA);
+
+        // Perturbacin simultnea de Bernoulli (+1/-1)
+        std::vector<double> delta(TUNED_PARAM_COUNT);
+        std::vector<double> plus(TUNED_PARAM_COUNT);
+        std::vector<double> minus(TUNED_PARAM_COUNT);
+        for (int i = 0; i < TUNED_PARAM_COUNT; i++)
+        {
+            delta[i] = (random() & 1) ? 1.0 : -1.0;
+            plus[i] = std::min(std::max(values[i] + ck * delta[i], 0.0), 1.0);
+            minus[i] = std::min(std::max(values[i] - ck * delta[i], 0.0), 1.0);
+        }
+
+        double result = playMatch(toSearchParams(base, plus),
+                                  toSearchParams(base, minus),
+                                  games,
+                                  threads,
+                                  (unsigned int)random());
+
+        // Gradiente estimado y paso de ascenso
+        for (int i = 0; i < TUNED_PARAM_COUNT; i++)
+        {
+            values[i] += ak * result / (2 * ck * delta[i]);
+            values[i] = std::min(std::max(values[i], 0.0), 1.0);
+        }
+
+        SearchParams params = toSearchParams(base, values);
+        params.moveTimeMs = savedMoveTimeMs;
+        saveSearchParams(output, params);
+
+        printf("iteration %d/%d: result %+.3f", k + 1, iterations, result);
+        for (int i = 0; i < TUNED_PARAM_COUNT; i++)
+            printf(" %s=%d", TUNED_PARAMS[i].name, params.*findParamField(TUNED_PARAMS[i].name));
+        printf("\n");
+        fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,359 @@
+/**
+ * @brief Differential validation of the bitboard rules kernel against the
+ * reference getValidMoves()/playMove() (no raylib)
+ * @author Marc S. Ressl
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "ai.h"
+#include "bitboard.h"
+#include "model.h"
+
+#define DEFAULT_RANDOM_GAMES 10000
+#define DEFAULT_ENGINE_GAMES 20
+#define DEFAULT_ENGINE_DEPTH 2
+
+// Jugadas al azar al comienzo de las partidas del motor (si no, todas
+// seran iguales)
+#define OPENING_RANDOM_PLIES 6
+
+// Diferencias que se muestran antes de abandonar
+#define MAX_REPORTED_MISMATCHES 10
+
+/**
+ * @brief Counts of the run.
+ */
+struct ValidationStats
+{
+    long long games;
+    long long plies;
+    long long moves;
+    long long passes;
+    long long gameOvers;
+    long long mismatches;
+
+    // Operaciones (generaciones de jugadas y jugadas aplicadas) y tiempo
+    // de cada implementacin, sobre las mismas posiciones y con el mismo
+    // trabajo: cada jugada se aplica sobre una copia de la posicin
+    long long operations;
+    double referenceTime;
+    double bitboardTime;
+};
+
+static double getElapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint64_t getMovesMask(const Moves &moves)
+{
+    uint64_t mask = 0;
+    for (auto move : moves)
+        mask |= SQUARE_BIT(move);
+
+    return mask;
+}
+
+/**
+ * @brief Returns the discs of a player that were not there before.
+ */
+static uint64_t getNewDiscs(GameModel &before, GameModel &after, Piece piece)
+{
+    uint64_t mask = 0;
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+            if ((after.board[y][x] == piece) && (before.board[y][x] != piece))
+                mask |= (uint64_t)1 << (y * BOARD_SIZE + x);
+
+    return mask;
+}
+
+static void reportMismatch(ValidationStats &stats, GameModel &model, const char *what,
+                           int square, uint64_t expected, uint64_t actual)
+{
+    stats.mismatches++;
+    if (stats.mismatches > MAX_REPORTED_MISMATCHES)
+        return;
+
+    char position[POSITION_STRING_SIZE];
+    getPositionString(model, position);
+
+    char move[3] = "--";
+    if (square >= 0)
+    {
+        Square moveSquare = {square % BOARD_SIZE, square / BOARD_SIZE};
+        getSquareName(moveSquare, move);
+    }
+
+    printf("MISMATCH %s at %s, move %s: reference %016llx, bitboard %016llx\n",
+           what, position, move,
+           (unsigned long long)expected, (unsigned long long)actual);
+}
+
+// Jugadas por posicin reservadas en los buffers (el mximo real es menor)
+#define MAX_POSITION_MOVES (BOARD_SIZE * BOARD_SIZE)
+
+/**
+ * @brief The outputs of both implementations for the positions of a game,
+ * kept between games so that nothing is allocated while timing.
+ */
+struct ValidationBuffers
+{
+    std::vector<Bitboard> boards;
+
+    // Referencia: jugadas y posicin despus de cada una
+    std::vector<Moves> referenceMoves;
+    std::vector<GameModel> referenceChildren;
+
+    // Bitboards, por casilla: jugadas, posicin despus, volteos, pase y
+    // fin del juego
+    std::vector<uint64_t> bitboardMoves;
+    std::vector<Bitboard> bitboardChildren;
+    std::vector<uint64_t> bitboardFlips;
+    std::vector<uint8_t> bitboardPassed;
+    std::vector<uint8_t> bitboardOver;
+};
+
+/**
+ * @brief Runs the reference on every position: move generation, then
+ * each move played on a copy (applyMove(): the rules of playMove(),
+ * without reading the clock).
+ */
+static void runReference(std::vector<GameModel> &positions, ValidationBuffers &buffers)
+{
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        Moves &moves = buffers.referenceMoves[i];
+        moves.clear();
+        getValidMoves(positions[i], moves);
+
+        for (size_t j = 0; j < moves.size(); j++)
+        {
+            GameModel &child = buffers.referenceChildren[i * MAX_POSITION_MOVES + j];
+            child = positions[i];
+            applyMove(child, moves[j]);
+        }
+    }
+}
+
+/**
+ * @brief Runs the bitboard kernel on every position: move generation,
+ * then each move played on a copy (one flip computation per move).
+ */
+static void runBitboard(size_t count, ValidationBuffers &buffers)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t moves = getBitboardMoves(buffers.boards[i]);
+        buffers.bitboardMoves[i] = moves;
+
+        for (int square = 0; moves; square++, moves >>= 1)
+        {
+            if (!(moves & 1))
+                continue;
+
+            size_t index = i * MAX_POSITION_MOVES + square;
+            bool passed;
+
+            buffers.bitboardChildren[index] = buffers.boards[i];
+            buffers.bitboardOver[index] = playBitboardMove(buffers.bitboardChildren[index], square,
+                                                           buffers.bitboardFlips[index], passed);
+            buffers.bitboardPassed[index] = passed;
+        }
+    }
+}
+
+/**
+ * @brief Cross-checks the positions of a game: legal moves, and for every
+ * legal move its flips, the resulting board, passes and game over.
+ *
+ * Each implementation runs over all the positions in one timed pass, on
+ * inputs prepared beforehand, so that both time the same work.
+ */
+static void validatePositions(ValidationStats &stats,
+                              std::vector<GameModel> &positions,
+                              ValidationBuffers &buffers)
+{
+    size_t count = positions.size();
+
+    if (buffers.boards.size() < count)
+    {
+        buffers.boards.resize(count);
+        buffers.referenceMoves.resize(count);
+        buffers.referenceChildren.resize(count * MAX_POSITION_MOVES);
+        buffers.bitboardMoves.resize(count);
+        buffers.bitboardChildren.resize(count * MAX_POSITION_MOVES);
+        buffers.bitboardFlips.resize(count * MAX_POSITION_MOVES);
+        buffers.bitboardPassed.resize(count * MAX_POSITION_MOVES);
+        buffers.bitboardOver.resize(count * MAX_POSITION_MOVES);
+    }
+
+    for (size_t i = 0; i < count; i++)
+        buffers.boards[i] = getBitboard(positions[i]);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    runReference(positions, buffers);
+    stats.referenceTime += getElapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    runBitboard(count, buffers);
+    stats.bitboardTime += getElapsed(start);
+
+    // Comparacin
+    for (size_t i = 0; i < count; i++)
+    {
+        GameModel &model = positions[i];
+        Moves &moves = buffers.referenceMoves[i];
+        Piece playerPiece = (model.currentPlayer == PLAYER_WHITE) ? PIECE_WHITE : PIECE_BLACK;
+
+        uint64_t referenceMoves = getMovesMask(moves);
+        if (referenceMoves != buffers.bitboardMoves[i])
+        {
+            reportMismatch(stats, model, "legal moves", -1, referenceMoves, buffers.bitboardMoves[i]);
+            continue;
+        }
+
+        for (size_t j = 0; j < moves.size(); j++)
+        {
+            GameModel &child = buffers.referenceChildren[i * MAX_POSITION_MOVES + j];
+            int square = moves[j].y * BOARD_SIZE + moves[j].x;
+            size_t index = i * MAX_POSITION_MOVES + square;
+
+            uint64_t referenceFlips = getNewDiscs(model, child, playerPiece) & ~SQUARE_BIT(moves[j]);
+            if (referenceFlips != buffers.bitboardFlips[index])
+                reportMismatch(stats, model, "flips", square, referenceFlips, buffers.bitboardFlips[index]);
+
+            // El tablero resultante, desde el jugador que mueve despus
+            Bitboard referenceChild = getBitboard(child);
+            Bitboard &bitboardChild = buffers.bitboardChildren[index];
+            if ((referenceChild.player != bitboardChild.player) ||
+                (referenceChild.opponent != bitboardChild.opponent))
+                reportMismatch(stats, model, "board after move", square,
+                               referenceChild.player, bitboardChild.player);
+
+            bool referencePassed = (child.currentPlayer == model.currentPlayer);
+            if (referencePassed != (bool)buffers.bitboardPassed[index])
+                reportMismatch(stats, model, "pass", square, referencePassed, buffers.bitboardPassed[index]);
+
+            if (child.gameOver != (bool)buffers.bitboardOver[index])
+                reportMismatch(stats, model, "game over", square, child.gameOver, buffers.bitboardOver[index]);
+
+            stats.passes += referencePassed && !child.gameOver;
+            stats.gameOvers += child.gameOver;
+        }
+
+        stats.moves += moves.size();
+        stats.operations += 1 + moves.size();
+    }
+
+    stats.plies += count;
+}
+
+/**
+ * @brief Plays a game, then validates every position of it.
+ */
+static void playGame(ValidationStats &stats, std::mt19937 &random,
+                     const SearchParams *engineParams,
+                     std::vector<GameModel> &positions,
+                     ValidationBuffers &buffers)
+{
+    GameModel model;
+    initModel(model);
+    startModel(model);
+
+    positions.clear();
+    for (int ply = 0; !model.gameOver; ply++)
+    {
+        positions.push_back(model);
+
+        Moves moves;
+        getValidMoves(model, moves);
+
+        if (engineParams && (ply >= OPENING_RANDOM_PLIES))
+            playMove(model, getBestMove(model, *engineParams));
+        else
+            playMove(model, moves[random() % moves.size()]);
+    }
+
+    validatePositions(stats, positions, buffers);
+    stats.games++;
+}
+
+static void printUsage()
+{
+    printf("usage: validate [--random-games N] [--engine-games N] [--depth N] [--seed N]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    long long randomGames = DEFAULT_RANDOM_GAMES;
+    long long engineGames = DEFAULT_ENGINE_GAMES;
+    int depth = DEFAULT_ENGINE_DEPTH;
+    unsigned int seed = std::random_device{}();
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((i + 1 < argc) && (strcmp(argv[i], "--random-games") == 0))
+            randomGames = atoll(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--engine-games") == 0))
+            engineGames = atoll(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--depth") == 0))
+            depth = atoi(argv[++i]);
+        else if ((i + 1 < argc) && (strcmp(argv[i], "--seed") == 0))
+            seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // La semilla permite repetir una corrida que encontr diferencias
+    printf("seed %u\n", seed);
+    std::mt19937 random(seed);
+
+    SearchParams engineParams = getDefaultSearchParams();
+    engineParams.earlyGameDepth = depth;
+    engineParams.midGameDepth = depth;
+    engineParams.endGameDepth = depth;
+    engineParams.searchThreads = 1;
+
+    ValidationStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    std::vector<GameModel> positions;
+    ValidationBuffers buffers;
+
+    for (long long game = 0; (game < randomGames) && (stats.mismatches <= MAX_REPORTED_MISMATCHES); game++)
+        playGame(stats, random, nullptr, positions, buffers);
+    for (long long game = 0; (game < engineGames) && (stats.mismatches <= MAX_REPORTED_MISMATCHES); game++)
+        playGame(stats, random, &engineParams, positions, buffers);
+
+    printf("%lld games, %lld positions, %lld moves, %lld passes, %lld game overs\n",
+           stats.games, stats.plies, stats.moves, stats.passes, stats.gameOvers);
+    printf("%-10s %10s %12s\n", "kernel", "time s", "Mops/s");
+    printf("%-10s %10.3f %12.2f\n", "reference", stats.referenceTime,
+           (stats.referenceTime > 0) ? stats.operations / stats.referenceTime / 1e6 : 0);
+    printf("%-10s %10.3f %12.2f\n", "bitboard", stats.bitboardTime,
+           (stats.bitboardTime > 0) ? stats.operations / stats.bitboardTime / 1e6 : 0);
+    if (stats.bitboardTime > 0)
+        printf("speedup %.1fx\n", stats.referenceTime / stats.bitboardTime);
+
+    if (stats.mismatches)
+    {
+        printf("FAILED: %lld mismatches\n", stats.mismatches);
+        return 1;
+    }
+
+    printf("OK: bitboard kernel matches the reference\n");
+
+    return 0;
+}
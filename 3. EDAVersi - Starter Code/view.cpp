@@ -5,12 +5,26 @@
  * @copyright Copyright (c) 2023-2024
  */
 
-#include <string>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <thread>
 
 #include "raylib.h"
+#include "rlgl.h"
 
+#include "alloc.h"
+#include "analysis.h"
 #include "controller.h"
 #include "model.h"
+#include "review.h"
+#include "searchinfo.h"
+#include "tournament.h"
+#include "view.h"
 
 #define GAME_NAME "EDAversi"
 
@@ -59,76 +73,780 @@
 #define INFO_PLAYWHITE_BUTTON_X INFO_CENTERED_X
 #define INFO_PLAYWHITE_BUTTON_Y (WINDOW_HEIGHT * 7 / 8)
 
+#define INFO_SEARCH_FONT_SIZE 20
+#define INFO_SEARCH_Y (INFO_TITLE_Y + TITLE_FONT_SIZE / 2 + 24)
+#define INFO_SEARCH_LINE_HEIGHT 24
+
+#define HINT_FONT_SIZE 20
+
+#define REVIEW_CHART_WIDTH 480
+#define REVIEW_CHART_HEIGHT 60
+#define REVIEW_CHART_X (INFO_CENTERED_X - REVIEW_CHART_WIDTH / 2)
+#define REVIEW_CHART_Y (INFO_WHITE_TIME_Y + SUBTITLE_FONT_SIZE + 16)
+#define REVIEW_FONT_SIZE 20
+#define REVIEW_TEXT_Y (REVIEW_CHART_Y - REVIEW_FONT_SIZE / 2 - 4)
+
+#define HIGHLIGHT_COLOR Color{ 255, 203, 0, 255 }
+
+#define SPECTATOR_HEADER_HEIGHT 48
+#define SPECTATOR_PADDING 6
+
+#define DEBUG_FONT_SIZE 20
+#define DEBUG_OVERLAY_X (OUTERBORDER_SIZE + 10)
+#define DEBUG_OVERLAY_Y 10
+
+// Capa esttica del tablero (borde y casillas), dibujada una sola vez
+static RenderTexture2D boardTexture;
+
+/**
+ * @brief Renders the static board layer into boardTexture.
+ */
+static void renderBoardTexture()
+{
+    boardTexture = LoadRenderTexture(OUTERBORDER_SIZE, OUTERBORDER_SIZE);
+
+    BeginTextureMode(boardTexture);
+
+    ClearBackground(BLACK);
+
+    for (int y = 0; y < BOARD_SIZE; y++)
+        for (int x = 0; x < BOARD_SIZE; x++)
+        {
+            Vector2 position = {
+                BOARD_X - OUTERBORDER_X + (float)x * SQUARE_SIZE,
+                BOARD_Y - OUTERBORDER_Y + (float)y * SQUARE_SIZE };
+
+            DrawRectangleRounded(
+                { position.x + SQUARE_CONTENT_OFFSET,
+                 position.y + SQUARE_CONTENT_OFFSET,
+                 SQUARE_CONTENT_SIZE,
+                 SQUARE_CONTENT_SIZE },
+                0.2F,
+                6,
+                DARKGREEN);
+        }
+
+    EndTextureMode();
+}
+
+/**
+ * @brief Sprites of the disc atlas.
+ */
+enum Sprite
+{
+    SPRITE_BLACK_DISC,
+    SPRITE_WHITE_DISC,
+    SPRITE_BLACK_HINT,
+    SPRITE_WHITE_HINT,
+    SPRITE_BEST_MOVE,
+    SPRITE_COUNT,
+};
+
+#define SPRITE_SIZE SQUARE_SIZE
+#define SPRITE_SUPERSAMPLE 4
+
+#define BEST_MOVE_INNER_RADIUS (PIECE_RADIUS + 1)
+#define BEST_MOVE_OUTER_RADIUS (PIECE_RADIUS + 5)
+
+#define SPRITE_QUEUE_SIZE 4096
+
+// Atlas con fichas e indicadores pre-renderizados (con antialiasing)
+static Texture2D spriteAtlas;
+
+/**
+ * @brief A queued sprite, drawn in the next batched pass.
+ */
+struct SpriteQuad
+{
+    Sprite sprite;
+    Vector2 position;
+    float size;
+};
+
+// Cola de sprites del cuadro actual (tamao fijo, sin memoria dinmica)
+static SpriteQuad spriteQueue[SPRITE_QUEUE_SIZE];
+static int spriteQueueSize;
+
+// Estadsticas del ltimo cuadro, para la capa de depuracin
+static int drawCalls;
+static int spritesDrawn;
+static bool showDebugOverlay;
+
+/**
+ * @brief Draws a circle (or a ring, if innerRadius is positive) into an
+ * atlas slot, with its edges anti-aliased by supersampling.
+ *
+ * @param image The atlas image.
+ * @param sprite The atlas slot.
+ * @param innerRadius The inner radius (0 for a filled circle).
+ * @param radius The outer radius.
+ * @param color The circle color.
+ */
+static void drawAtlasCircle(Image &image,
+    Sprite sprite,
+    float innerRadius,
+    float radius,
+    Color color)
+{
+    Color *pixels = (Color *)image.data;
+    float center = SPRITE_SIZE / 2.0F;
+    const int samples = SPRITE_SUPERSAMPLE * SPRITE_SUPERSAMPLE;
+
+    for (int y = 0; y < SPRITE_SIZE; y++)
+        for (int x = 0; x < SPRITE_SIZE; x++)
+        {
+            // Cobertura del pxel: fraccin de submuestras dentro del crculo
+            int inside = 0;
+            for (int sy = 0; sy < SPRITE_SUPERSAMPLE; sy++)
+                for (int sx = 0; sx < SPRITE_SUPERSAMPLE; sx++)
+                {
+                    float dx = x + (sx + 0.5F) / SPRITE_SUPERSAMPLE - center;
+                    float dy = y + (sy + 0.5F) / SPRITE_SUPERSAMPLE - center;
+                    float distance2 = dx * dx + dy * dy;
+                    if ((distance2 <= radius * radius) &&
+                        (distance2 >= innerRadius * innerRadius))
+                        inside++;
+                }
+
+            // El color se mantiene en los bordes transparentes para que el
+            // filtrado bilineal no oscurezca el contorno
+            Color pixel = color;
+            pixel.a = (unsigned char)(color.a * inside / samples);
+
+            pixels[y * image.width + sprite * SPRITE_SIZE + x] = pixel;
+        }
+}
+
+/**
+ * @brief Renders the disc and hint sprites into spriteAtlas.
+ */
+static void renderSpriteAtlas()
+{
+    Image image = GenImageColor(SPRITE_COUNT * SPRITE_SIZE, SPRITE_SIZE, BLANK);
+
+    drawAtlasCircle(image, SPRITE_BLACK_DISC, 0, PIECE_RADIUS, BLACK);
+    drawAtlasCircle(image, SPRITE_WHITE_DISC, 0, PIECE_RADIUS, WHITE);
+    drawAtlasCircle(image, SPRITE_BLACK_HINT, 0, VALID_MOVE_RADIUS,
+        Color{ 50, 50, 50, 150 });      // Negro semi-transparente
+    drawAtlasCircle(image, SPRITE_WHITE_HINT, 0, VALID_MOVE_RADIUS,
+        Color{ 255, 255, 255, 150 });   // Blanco semi-transparente
+    drawAtlasCircle(image, SPRITE_BEST_MOVE,
+        BEST_MOVE_INNER_RADIUS, BEST_MOVE_OUTER_RADIUS,
+        HIGHLIGHT_COLOR);               // Mejor jugada de la bsqueda
+
+    spriteAtlas = LoadTextureFromImage(image);
+
+    // Mipmaps: los tableros reducidos del modo espectador siguen suaves
+    GenTextureMipmaps(&spriteAtlas);
+    SetTextureFilter(spriteAtlas, TEXTURE_FILTER_TRILINEAR);
+
+    UnloadImage(image);
+}
+
+/**
+ * @brief Draws all queued sprites in a single textured-quad batch.
+ */
+static void flushSprites()
+{
+    if (!spriteQueueSize)
+        return;
+
+    float atlasWidth = (float)spriteAtlas.width;
+
+    rlCheckRenderBatchLimit(4 * spriteQueueSize);
+
+    rlSetTexture(spriteAtlas.id);
+    rlBegin(RL_QUADS);
+
+    rlColor4ub(255, 255, 255, 255);
+    rlNormal3f(0.0F, 0.0F, 1.0F);
+
+    for (int i = 0; i < spriteQueueSize; i++)
+    {
+        const SpriteQuad &quad = spriteQueue[i];
+
+        float u0 = quad.sprite * SPRITE_SIZE / atlasWidth;
+        float u1 = (quad.sprite + 1) * SPRITE_SIZE / atlasWidth;
+        float x0 = quad.position.x;
+        float y0 = quad.position.y;
+        float x1 = x0 + quad.size;
+        float y1 = y0 + quad.size;
+
+        rlTexCoord2f(u0, 0.0F);
+        rlVertex2f(x0, y0);
+        rlTexCoord2f(u0, 1.0F);
+        rlVertex2f(x0, y1);
+        rlTexCoord2f(u1, 1.0F);
+        rlVertex2f(x1, y1);
+        rlTexCoord2f(u1, 0.0F);
+        rlVertex2f(x1, y0);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+
+    drawCalls++;
+    spritesDrawn += spriteQueueSize;
+    spriteQueueSize = 0;
+}
+
+/**
+ * @brief Queues a sprite for the next batched pass.
+ *
+ * @param sprite The sprite.
+ * @param position The top-left corner of its square.
+ * @param size The size of its square.
+ */
+static void queueSprite(Sprite sprite,
+    Vector2 position,
+    float size = SPRITE_SIZE)
+{
+    if (spriteQueueSize == SPRITE_QUEUE_SIZE)
+        flushSprites();
+
+    spriteQueue[spriteQueueSize].sprite = sprite;
+    spriteQueue[spriteQueueSize].position = position;
+    spriteQueue[spriteQueueSize].size = size;
+    spriteQueueSize++;
+}
+
+#define FRAME_TIME (1.0 / 60)
+
+/**
+ * @brief Everything visible that can change between frames.
+ */
+struct ViewState
+{
+    bool valid;
+
+    unsigned int boardVersion;
+    bool gameOver;
+    Player currentPlayer;
+    Player humanPlayer;
+
+    int timerSeconds[2];
+
+    // Snapshots de bsqueda mostrados (0: ninguno); la IA y el anlisis
+    // numeran sus snapshots por separado, as que cuenta tambin cul es
+    const SearchInfo *searchInfoSnapshot;
+    unsigned int searchInfoSequence;
+    unsigned int hintInfoSequence;
+
+    bool editing;
+
+    int reviewProgress;
+    int reviewTotal;
+    int reviewPly;
+    bool reviewReady;
+};
+
+// Estado del ltimo cuadro dibujado
+static ViewState drawnState;
+
+// Progreso de la bsqueda de la IA a mostrar (nullptr: ninguno)
+static const SearchInfo *searchInfo;
+
+// Valores de las pistas a mostrar (nullptr: ninguno)
+static const SearchInfo *hintInfo;
+
+// Editor de posiciones activo
+static bool editMode;
+
+// Revisin de la partida (nullptr: en curso o ninguna)
+static const std::vector<ReviewMove> *reviewMoves;
+static int reviewProgress;
+static int reviewTotal;
+static int reviewPly;
+
+/**
+ * @brief Returns the current visible state.
+ */
+static ViewState getViewState(GameModel &model)
+{
+    ViewState state;
+
+    state.valid = true;
+
+    state.boardVersion = model.version;
+    state.gameOver = model.gameOver;
+    state.currentPlayer = model.currentPlayer;
+    state.humanPlayer = model.humanPlayer;
+
+    state.timerSeconds[PLAYER_BLACK] = (int)getTimer(model, PLAYER_BLACK);
+    state.timerSeconds[PLAYER_WHITE] = (int)getTimer(model, PLAYER_WHITE);
+
+    state.searchInfoSnapshot = searchInfo;
+    state.searchInfoSequence = searchInfo ? searchInfo->sequence : 0;
+    state.hintInfoSequence = hintInfo ? hintInfo->sequence : 0;
+
+    state.editing = editMode;
+
+    state.reviewProgress = reviewProgress;
+    state.reviewTotal = reviewTotal;
+    state.reviewPly = reviewPly;
+    state.reviewReady = (reviewMoves != nullptr);
+
+    return state;
+}
+
+static bool isSameViewState(const ViewState &a, const ViewState &b)
+{
+    return a.valid && b.valid &&
+           (a.boardVersion == b.boardVersion) &&
+           (a.gameOver == b.gameOver) &&
+           (a.currentPlayer == b.currentPlayer) &&
+           (a.humanPlayer == b.humanPlayer) &&
+           (a.timerSeconds[0] == b.timerSeconds[0]) &&
+           (a.timerSeconds[1] == b.timerSeconds[1]) &&
+           (a.searchInfoSnapshot == b.searchInfoSnapshot) &&
+           (a.searchInfoSequence == b.searchInfoSequence) &&
+           (a.hintInfoSequence == b.hintInfoSequence) &&
+           (a.editing == b.editing) &&
+           (a.reviewProgress == b.reviewProgress) &&
+           (a.reviewTotal == b.reviewTotal) &&
+           (a.reviewPly == b.reviewPly) &&
+           (a.reviewReady == b.reviewReady);
+}
+
+// GLFW (incluido en raylib): despierta a PollInputEvents() mientras espera
+// eventos; se puede llamar desde cualquier hilo
+extern "C" void glfwPostEmptyEvent(void);
+
+// Despertador de la espera de eventos: cuando cambia el segundo de un
+// reloj visible, publica un evento vaco
+static std::thread wakeThread;
+static std::mutex wakeMutex;
+static std::condition_variable wakeCondition;
+static bool wakeScheduled;
+static bool wakeStopRequested;
+static std::chrono::steady_clock::time_point wakeTime;
+
+static void runWakeThread()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex);
+
+    while (!wakeStopRequested)
+    {
+        if (!wakeScheduled)
+        {
+            wakeCondition.wait(lock);
+            continue;
+        }
+
+        if (wakeCondition.wait_until(lock, wakeTime) == std::cv_status::timeout)
+        {
+            wakeScheduled = false;
+            glfwPostEmptyEvent();
+        }
+    }
+}
+
+/**
+ * @brief Schedules (or cancels, with seconds < 0) an empty event.
+ */
+static void scheduleWake(double seconds)
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+
+        wakeScheduled = (seconds >= 0);
+        wakeTime = std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                       std::chrono::duration<double>(seconds));
+    }
+    wakeCondition.notify_one();
+}
+
 void initView()
 {
     InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, GAME_NAME);
 
     SetTargetFPS(60);
+
+    renderBoardTexture();
+    renderSpriteAtlas();
+
+    wakeScheduled = false;
+    wakeStopRequested = false;
+    wakeThread = std::thread(runWakeThread);
 }
 
 void freeView()
 {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeStopRequested = true;
+    }
+    wakeCondition.notify_one();
+    wakeThread.join();
+
+    UnloadTexture(spriteAtlas);
+    UnloadRenderTexture(boardTexture);
+
     CloseWindow();
 }
 
+#define HUD_TEXT_SIZE 64
+
+/**
+ * @brief A HUD text, formatted and measured only when its value changes.
+ */
+struct HudText
+{
+    bool valid;
+    int value;
+    int fontSize;
+    int width;
+    char text[HUD_TEXT_SIZE];
+};
+
+// Textos del HUD: se formatean en buffers fijos, sin memoria dinmica
+static HudText titleText;
+static HudText scoreTexts[2];
+static HudText timerTexts[2];
+static HudText playBlackText;
+static HudText playWhiteText;
+static HudText editText;
+static HudText reviewText;
+static HudText searchTexts[3];
+static HudText hintTexts[SEARCH_INFO_MAX_LINES];
+
+/**
+ * @brief Sets a constant HUD text, measuring it only the first time.
+ *
+ * @param hud The HUD text.
+ * @param s The string.
+ * @param fontSize The font size.
+ */
+static void setStaticText(HudText &hud,
+    const char *s,
+    int fontSize)
+{
+    if (hud.valid)
+        return;
+
+    snprintf(hud.text, sizeof(hud.text), "%s", s);
+    hud.fontSize = fontSize;
+    hud.width = MeasureText(hud.text, fontSize);
+    hud.valid = true;
+}
+
+/**
+ * @brief Sets a score HUD text, reformatting it only when the score changes.
+ *
+ * @param hud The HUD text.
+ * @param label The label before the score.
+ * @param score The score.
+ */
+static void setScoreText(HudText &hud,
+    const char *label,
+    int score)
+{
+    if (hud.valid && hud.value == score)
+        return;
+
+    snprintf(hud.text, sizeof(hud.text), "%s%d", label, score);
+    hud.value = score;
+    hud.fontSize = SUBTITLE_FONT_SIZE;
+    hud.width = MeasureText(hud.text, SUBTITLE_FONT_SIZE);
+    hud.valid = true;
+}
+
+/**
+ * @brief Sets a timer HUD text, reformatting it only when the displayed
+ * second changes.
+ *
+ * @param hud The HUD text.
+ * @param time The number of seconds of the timer.
+ */
+static void setTimerText(HudText &hud,
+    double time)
+{
+    int totalSeconds = (int)time;
+
+    if (hud.valid && hud.value == totalSeconds)
+        return;
+
+    int seconds = totalSeconds % 60;
+    int minutes = totalSeconds / 60;
+
+    snprintf(hud.text, sizeof(hud.text), "%02d:%02d", minutes, seconds);
+    hud.value = totalSeconds;
+    hud.fontSize = SUBTITLE_FONT_SIZE;
+    hud.width = MeasureText(hud.text, SUBTITLE_FONT_SIZE);
+    hud.valid = true;
+}
+
+/**
+ * @brief Draws the debug overlay with the draw-call count.
+ */
+static void drawDebugOverlay()
+{
+    static char text[HUD_TEXT_SIZE * 2];
+    static int formattedDrawCalls = -1;
+    static int formattedSprites = -1;
+
+    // La propia capa es una llamada ms
+    drawCalls++;
+
+    if (drawCalls != formattedDrawCalls ||
+        spritesDrawn != formattedSprites)
+    {
+        snprintf(text, sizeof(text), "Draw calls: %d  Sprites: %d",
+            drawCalls, spritesDrawn);
+        formattedDrawCalls = drawCalls;
+        formattedSprites = spritesDrawn;
+    }
+
+    DrawText(text,
+        DEBUG_OVERLAY_X,
+        DEBUG_OVERLAY_Y,
+        DEBUG_FONT_SIZE,
+        DARKGRAY);
+}
+
+/**
+ * @brief Formats a HUD text and measures it.
+ *
+ * @param hud The HUD text.
+ * @param fontSize The font size.
+ * @param format The printf format.
+ */
+static void formatText(HudText &hud,
+    int fontSize,
+    const char *format,
+    ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(hud.text, sizeof(hud.text), format, args);
+    va_end(args);
+
+    hud.fontSize = fontSize;
+    hud.width = MeasureText(hud.text, fontSize);
+    hud.valid = true;
+}
+
 /**
  * @brief Draws centered text.
  *
  * @param position The center position for the text.
- * @param fontSize The font size.
- * @param s The string.
+ * @param hud The HUD text.
  */
 static void drawCenteredText(Vector2 position,
-    int fontSize,
-    std::string s)
+    const HudText &hud)
 {
-    DrawText(s.c_str(),
-        (int)position.x - MeasureText(s.c_str(), fontSize) / 2,
-        (int)position.y - fontSize / 2,
-        fontSize,
+    DrawText(hud.text,
+        (int)position.x - hud.width / 2,
+        (int)position.y - hud.fontSize / 2,
+        hud.fontSize,
         BROWN);
+
+    drawCalls++;
 }
 
 /**
  * @brief Draws a player's score.
  *
+ * @param label The label before the score.
  * @param position The center position for the score.
+ * @param player The player.
  * @param score The score.
  */
-static void drawScore(std::string label,
+static void drawScore(const char *label,
     Vector2 position,
+    Player player,
     int score)
 {
-    std::string s = label + std::to_string(score);
+    setScoreText(scoreTexts[player], label, score);
 
-    drawCenteredText(position, SUBTITLE_FONT_SIZE, s);
+    drawCenteredText(position, scoreTexts[player]);
 }
 
 /**
  * @brief Draws a player's timer.
  *
  * @param position The center position for the timer.
+ * @param player The player.
  * @param time The number of seconds of the timer.
  */
 static void drawTimer(Vector2 position,
+    Player player,
     double time)
 {
-    int totalSeconds = (int)time;
+    setTimerText(timerTexts[player], time);
 
-    int seconds = totalSeconds % 60;
-    int minutes = totalSeconds / 60;
+    drawCenteredText(position, timerTexts[player]);
+}
+
+/**
+ * @brief Draws the progress of the AI search: depth, nodes, speed, best
+ * move, score and principal variation.
+ *
+ * @param info The search snapshot.
+ */
+static void drawSearchInfo(const SearchInfo &info)
+{
+    // Snapshot formateado: la IA y el anlisis tienen canales distintos,
+    // con nmeros de secuencia independientes
+    static const SearchInfo *formattedInfo;
+    static unsigned int formattedSequence;
+
+    // Se reformatea solo con un snapshot nuevo (pocas veces por segundo)
+    if (!searchTexts[0].valid || (&info != formattedInfo) ||
+        (info.sequence != formattedSequence))
+    {
+        long long nodesPerSecond = (info.time > 0) ? (long long)(info.nodes / info.time) : 0;
+
+        if (isAllocTrackingEnabled())
+            formatText(searchTexts[0], INFO_SEARCH_FONT_SIZE,
+                "Depth %d  Nodes %lld  %lld kN/s  %.1f alloc/N",
+                info.depth, info.nodes, nodesPerSecond / 1000,
+                info.nodes ? (double)info.allocations / info.nodes : 0.0);
+        else
+            formatText(searchTexts[0], INFO_SEARCH_FONT_SIZE,
+                "Depth %d  Nodes %lld  %lld kN/s",
+                info.depth, info.nodes, nodesPerSecond / 1000);
+
+        char bestMove[3] = "--";
+        if (isSquareValid(info.bestMove))
+            getSquareName(info.bestMove, bestMove);
+        formatText(searchTexts[1], INFO_SEARCH_FONT_SIZE,
+            "Best %s  Score %+d", bestMove, info.score);
+
+        char pv[HUD_TEXT_SIZE] = "PV";
+        int length = 2;
+        for (int i = 0; i < info.pvLength; i++)
+        {
+            pv[length++] = ' ';
+            getSquareName(info.pv[i], pv + length);
+            length += 2;
+        }
+        formatText(searchTexts[2], INFO_SEARCH_FONT_SIZE, "%s", pv);
+
+        formattedInfo = &info;
+        formattedSequence = info.sequence;
+    }
+
+    for (int i = 0; i < 3; i++)
+        drawCenteredText({ INFO_CENTERED_X,
+                          (float)(INFO_SEARCH_Y + i * INFO_SEARCH_LINE_HEIGHT) },
+            searchTexts[i]);
+}
+
+/**
+ * @brief Draws the score of each scored move on its hint disc.
+ *
+ * @param info The hint search snapshot.
+ */
+static void drawHintScores(const SearchInfo &info)
+{
+    static unsigned int formattedSequence;
+
+    if (info.sequence != formattedSequence)
+    {
+        for (int i = 0; i < info.lineCount; i++)
+            formatText(hintTexts[i], HINT_FONT_SIZE, "%+d", info.lineScores[i]);
 
-    std::string s;
+        formattedSequence = info.sequence;
+    }
+
+    for (int i = 0; i < info.lineCount; i++)
+    {
+        Square move = info.lineMoves[i];
 
-    if (minutes < 10)
-        s.append("0");
-    s.append(std::to_string(minutes));
-    s.append(":");
-    if (seconds < 10)
-        s.append("0");
-    s.append(std::to_string(seconds));
+        DrawText(hintTexts[i].text,
+            BOARD_X + move.x * SQUARE_SIZE + PIECE_CENTER - hintTexts[i].width / 2,
+            BOARD_Y + move.y * SQUARE_SIZE + PIECE_CENTER - HINT_FONT_SIZE / 2,
+            HINT_FONT_SIZE,
+            HIGHLIGHT_COLOR);
 
-    drawCenteredText(position, SUBTITLE_FONT_SIZE, s);
+        drawCalls++;
+    }
+}
+
+/**
+ * @brief Draws the post-game review: the average loss of each player and
+ * a bar per move (black's losses up, white's down), or the progress while
+ * it runs.
+ */
+static void drawReview()
+{
+    static int formattedProgress = -1;
+    static const std::vector<ReviewMove> *formattedMoves;
+
+    if (!reviewMoves)
+    {
+        if (!reviewText.valid || (formattedProgress != reviewProgress) || formattedMoves)
+        {
+            formatText(reviewText, REVIEW_FONT_SIZE, "Reviewing game... %d/%d",
+                reviewProgress, reviewTotal);
+            formattedProgress = reviewProgress;
+            formattedMoves = nullptr;
+        }
+
+        drawCenteredText({ INFO_CENTERED_X,
+                          REVIEW_TEXT_Y },
+            reviewText);
+        return;
+    }
+
+    const std::vector<ReviewMove> &moves = *reviewMoves;
+    int maxLoss = 1;
+    for (auto &review : moves)
+        maxLoss = std::max(maxLoss, review.loss);
+
+    if (!reviewText.valid || (formattedMoves != reviewMoves))
+    {
+        long long totalLoss[2] = { 0, 0 };
+        int moveCount[2] = { 0, 0 };
+
+        for (auto &review : moves)
+        {
+            if (!review.scored)
+                continue;
+
+            totalLoss[review.player] += review.loss;
+            moveCount[review.player]++;
+        }
+
+        formatText(reviewText, REVIEW_FONT_SIZE, "Average loss  black %.1f  white %.1f",
+            moveCount[PLAYER_BLACK] ? (double)totalLoss[PLAYER_BLACK] / moveCount[PLAYER_BLACK] : 0.0,
+            moveCount[PLAYER_WHITE] ? (double)totalLoss[PLAYER_WHITE] / moveCount[PLAYER_WHITE] : 0.0);
+        formattedMoves = reviewMoves;
+    }
+
+    drawCenteredText({ INFO_CENTERED_X,
+                      REVIEW_TEXT_Y },
+        reviewText);
+
+    float barWidth = (float)REVIEW_CHART_WIDTH / std::max(1, (int)moves.size());
+    float baseline = REVIEW_CHART_Y + REVIEW_CHART_HEIGHT / 2;
+
+    DrawLine(REVIEW_CHART_X, (int)baseline,
+        REVIEW_CHART_X + REVIEW_CHART_WIDTH, (int)baseline, DARKGRAY);
+    drawCalls++;
+
+    for (auto &review : moves)
+    {
+        if (!review.scored || !review.loss)
+            continue;
+
+        float height = (float)review.loss / maxLoss * (REVIEW_CHART_HEIGHT / 2);
+
+        DrawRectangleRec({ REVIEW_CHART_X + review.ply * barWidth,
+                          (review.player == PLAYER_BLACK) ? baseline - height : baseline,
+                          std::max(1.0F, barWidth - 1),
+                          height },
+            (review.player == PLAYER_BLACK) ? BLACK : WHITE);
+        drawCalls++;
+    }
+
+    // Jugada siguiente a la posicin mostrada
+    float marker = REVIEW_CHART_X + reviewPly * barWidth;
+    DrawLine((int)marker, REVIEW_CHART_Y,
+        (int)marker, REVIEW_CHART_Y + REVIEW_CHART_HEIGHT, HIGHLIGHT_COLOR);
+    drawCalls++;
 }
 
 /**
@@ -138,7 +856,7 @@ static void drawTimer(Vector2 position,
  * @param label The text of the button
  */
 static void drawButton(Vector2 position,
-    std::string label,
+    const HudText &label,
     Color backgroundColor)
 {
     DrawRectangle(position.x - INFO_BUTTON_WIDTH / 2,
@@ -146,11 +864,11 @@ static void drawButton(Vector2 position,
         INFO_BUTTON_WIDTH,
         INFO_BUTTON_HEIGHT,
         backgroundColor);
+    drawCalls++;
 
     drawCenteredText({ position.x,
                       position.y },
-        SUBTITLE_FONT_SIZE,
-        label.c_str());
+        label);
 }
 
 /**
@@ -168,24 +886,107 @@ static bool isMousePointerOverButton(Vector2 position)
         (mousePosition.y < (position.y + INFO_BUTTON_HEIGHT / 2)));
 }
 
+bool isViewDirty(GameModel& model)
+{
+    return IsWindowResized() ||
+           !isSameViewState(getViewState(model), drawnState);
+}
+
+void invalidateView()
+{
+    drawnState.valid = false;
+}
+
+void setSearchInfo(const SearchInfo *info)
+{
+    searchInfo = info;
+}
+
+void setHintInfo(const SearchInfo *info)
+{
+    hintInfo = info;
+}
+
+void setReview(const std::vector<ReviewMove> *moves, int progress, int total, int ply)
+{
+    reviewMoves = moves;
+    reviewProgress = progress;
+    reviewTotal = total;
+    reviewPly = ply;
+}
+
+void setEditMode(bool editing)
+{
+    editMode = editing;
+}
+
+void toggleDebugOverlay()
+{
+    showDebugOverlay = !showDebugOverlay;
+
+    invalidateView();
+}
+
+void waitView(GameModel& model, bool searching)
+{
+    if (searching || searchInfo || (reviewTotal && !reviewMoves))
+    {
+        // Una bsqueda o la revisin avanzan por su cuenta: revisar una vez
+        // por cuadro
+        WaitTime(FRAME_TIME);
+        PollInputEvents();
+        return;
+    }
+
+    // Bloquear hasta el prximo evento o, con un reloj corriendo, hasta
+    // que cambie el segundo que muestra
+    bool timerRunning = !model.gameOver && !editMode;
+    if (timerRunning)
+    {
+        double timer = getTimer(model, model.currentPlayer);
+        scheduleWake(floor(timer) + 1 - timer);
+    }
+
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+
+    if (timerRunning)
+        scheduleWake(-1);
+}
+
 void drawView(GameModel& model)
 {
+    drawnState = getViewState(model);
+
     BeginDrawing();
 
     ClearBackground(BEIGE);
 
-    DrawRectangle(
-        OUTERBORDER_X,
-        OUTERBORDER_Y,
-        OUTERBORDER_SIZE,
-        OUTERBORDER_SIZE,
-        BLACK);
+    // Las texturas de render estn invertidas verticalmente
+    drawCalls = 0;
+    spritesDrawn = 0;
+
+    DrawTextureRec(boardTexture.texture,
+        { 0,
+         0,
+         (float)boardTexture.texture.width,
+         -(float)boardTexture.texture.height },
+        { OUTERBORDER_X,
+         OUTERBORDER_Y },
+        WHITE);
+    drawCalls++;
 
-    // Obtener movimientos vlidos para el jugador actual
-    Moves validMoves;
-    if (!model.gameOver)
-        getValidMoves(model, validMoves);
+    // Movimientos vlidos del jugador actual (se regeneran solo tras una jugada)
+    uint64_t validMoves = getPositionAnalysis(model).validMoves;
 
+    bool showHints = !model.gameOver && !editMode &&
+                     (model.currentPlayer == model.humanPlayer);
+    Sprite hintSprite = (model.currentPlayer == PLAYER_BLACK)
+                            ? SPRITE_BLACK_HINT
+                            : SPRITE_WHITE_HINT;
+
+    // Fichas e indicadores se encolan y se dibujan en una sola pasada
     for (int y = 0; y < BOARD_SIZE; y++)
         for (int x = 0; x < BOARD_SIZE; x++)
         {
@@ -195,91 +996,222 @@ void drawView(GameModel& model)
                 BOARD_X + (float)square.x * SQUARE_SIZE,
                 BOARD_Y + (float)square.y * SQUARE_SIZE };
 
-            DrawRectangleRounded(
-                { position.x + SQUARE_CONTENT_OFFSET,
-                 position.y + SQUARE_CONTENT_OFFSET,
-                 SQUARE_CONTENT_SIZE,
-                 SQUARE_CONTENT_SIZE },
-                0.2F,
-                6,
-                DARKGREEN);
-
             Piece piece = getBoardPiece(model, square);
 
             if (piece != PIECE_EMPTY)
-            {
-                DrawCircle((int)position.x + PIECE_CENTER,
-                    (int)position.y + PIECE_CENTER,
-                    PIECE_RADIUS,
-                    (piece == PIECE_WHITE) ? WHITE : BLACK);
-            }
-            else if (!model.gameOver && model.currentPlayer == model.humanPlayer)
-            {
-                // Verificar si este cuadro es un movimiento vlido
-                bool isValidMove = false;
-                for (const auto& move : validMoves)
-                {
-                    if (move.x == square.x && move.y == square.y)
-                    {
-                        isValidMove = true;
-                        break;
-                    }
-                }
-
-                // Dibujar indicador si es un movimiento vlido
-                if (isValidMove)
-                {
-                    Color indicatorColor = (model.currentPlayer == PLAYER_BLACK)
-                        ? Color{ 50, 50, 50, 150 }    // Negro semi-transparente
-                    : Color{ 255, 255, 255, 150 }; // Blanco semi-transparente
-
-                    DrawCircle((int)position.x + PIECE_CENTER,
-                        (int)position.y + PIECE_CENTER,
-                        VALID_MOVE_RADIUS,
-                        indicatorColor);
-                }
-            }
+                queueSprite((piece == PIECE_WHITE) ? SPRITE_WHITE_DISC
+                                                   : SPRITE_BLACK_DISC,
+                    position);
+            else if (showHints && (validMoves & SQUARE_BIT(square)))
+                queueSprite(hintSprite, position);
         }
 
+    // Mejor jugada actual de la bsqueda de la IA
+    if (searchInfo && isSquareValid(searchInfo->bestMove))
+        queueSprite(SPRITE_BEST_MOVE,
+            { BOARD_X + (float)searchInfo->bestMove.x * SQUARE_SIZE,
+             BOARD_Y + (float)searchInfo->bestMove.y * SQUARE_SIZE });
+
+    flushSprites();
+
+    if (showHints && hintInfo)
+        drawHintScores(*hintInfo);
+
     drawScore("Black score: ",
         { INFO_CENTERED_X,
          INFO_WHITE_SCORE_Y },
+        PLAYER_BLACK,
         getScore(model,
             PLAYER_BLACK));
     drawTimer({ INFO_CENTERED_X,
                INFO_WHITE_TIME_Y },
+        PLAYER_BLACK,
         getTimer(model,
             PLAYER_BLACK));
+    setStaticText(titleText, GAME_NAME, TITLE_FONT_SIZE);
     drawCenteredText({ INFO_CENTERED_X,
                       INFO_TITLE_Y },
-        TITLE_FONT_SIZE,
-        GAME_NAME);
+        titleText);
     drawScore("White score: ",
         { INFO_CENTERED_X,
          INFO_BLACK_SCORE_Y },
+        PLAYER_WHITE,
         getScore(model,
             PLAYER_WHITE));
     drawTimer({ INFO_CENTERED_X,
                INFO_BLACK_TIME_Y },
+        PLAYER_WHITE,
         getTimer(model,
             PLAYER_WHITE));
 
-    if (model.gameOver)
+    if (editMode)
     {
+        // El jugador que mueve reemplaza a los botones
+        if (!editText.valid || (editText.value != model.currentPlayer))
+        {
+            formatText(editText, SUBTITLE_FONT_SIZE, "Edit: %s to move",
+                (model.currentPlayer == PLAYER_WHITE) ? "white" : "black");
+            editText.value = model.currentPlayer;
+        }
+
+        drawCenteredText({ INFO_PLAYBLACK_BUTTON_X,
+                          INFO_PLAYBLACK_BUTTON_Y },
+            editText);
+    }
+    else if (model.gameOver)
+    {
+        setStaticText(playBlackText, "Play black", SUBTITLE_FONT_SIZE);
+        setStaticText(playWhiteText, "Play white", SUBTITLE_FONT_SIZE);
+
         drawButton({ INFO_PLAYBLACK_BUTTON_X,
                     INFO_PLAYBLACK_BUTTON_Y },
-            "Play black",
+            playBlackText,
             BLACK);
 
         drawButton({ INFO_PLAYWHITE_BUTTON_X,
                     INFO_PLAYWHITE_BUTTON_Y },
-            "Play white",
+            playWhiteText,
+            WHITE);
+    }
+
+    if (searchInfo)
+        drawSearchInfo(*searchInfo);
+
+    if (reviewTotal && !editMode)
+        drawReview();
+
+    if (showDebugOverlay)
+        drawDebugOverlay();
+
+    EndDrawing();
+}
+
+// Modo espectador: ltima copia leda de cada tablero del torneo
+static MatchBoard spectatorBoards[TOURNAMENT_MAX_BOARDS];
+static TournamentResults spectatorResults;
+static bool spectatorValid;
+static HudText spectatorText;
+
+bool readSpectatorBoards()
+{
+    bool changed = !spectatorValid || IsWindowResized();
+
+    // Un tablero que se est escribiendo se lee en el prximo cuadro
+    for (int i = 0; i < getTournamentBoardCount(); i++)
+    {
+        MatchBoard board;
+        if (readTournamentBoard(i, board) &&
+            (board.sequence != spectatorBoards[i].sequence))
+        {
+            spectatorBoards[i] = board;
+            changed = true;
+        }
+    }
+
+    TournamentResults results = getTournamentResults();
+    if (!spectatorValid ||
+        (results.blackWins != spectatorResults.blackWins) ||
+        (results.whiteWins != spectatorResults.whiteWins) ||
+        (results.draws != spectatorResults.draws))
+    {
+        spectatorResults = results;
+        formatText(spectatorText, SUBTITLE_FONT_SIZE,
+            "Black %d   White %d   Draws %d",
+            results.blackWins, results.whiteWins, results.draws);
+        changed = true;
+    }
+
+    spectatorValid = true;
+
+    return changed;
+}
+
+void drawSpectatorView()
+{
+    int boards = getTournamentBoardCount();
+
+    // Grilla casi cuadrada que entra en la ventana bajo el encabezado
+    int columns = (int)ceil(sqrt((double)boards));
+    int rows = (boards + columns - 1) / columns;
+    float cellSize = fminf((float)WINDOW_WIDTH / columns,
+        (float)(WINDOW_HEIGHT - SPECTATOR_HEADER_HEIGHT) / rows);
+    float boardSize = cellSize - 2 * SPECTATOR_PADDING;
+    float scale = boardSize / OUTERBORDER_SIZE;
+    float gridX = (WINDOW_WIDTH - columns * cellSize) / 2;
+
+    BeginDrawing();
+
+    ClearBackground(BEIGE);
+
+    drawCalls = 0;
+    spritesDrawn = 0;
+
+    drawCenteredText({ WINDOW_WIDTH / 2,
+                      SPECTATOR_HEADER_HEIGHT / 2 },
+        spectatorText);
+
+    // Todos los tableros usan la misma textura: rlgl los agrupa en una llamada
+    for (int i = 0; i < boards; i++)
+    {
+        float x = gridX + (i % columns) * cellSize + SPECTATOR_PADDING;
+        float y = SPECTATOR_HEADER_HEIGHT + (i / columns) * cellSize + SPECTATOR_PADDING;
+
+        DrawTexturePro(boardTexture.texture,
+            { 0,
+             0,
+             (float)boardTexture.texture.width,
+             -(float)boardTexture.texture.height },
+            { x, y, boardSize, boardSize },
+            { 0, 0 },
+            0,
             WHITE);
     }
+    drawCalls++;
+
+    // Fichas de todos los tableros en una sola pasada
+    for (int i = 0; i < boards; i++)
+    {
+        const MatchBoard &board = spectatorBoards[i];
+
+        float x = gridX + (i % columns) * cellSize + SPECTATOR_PADDING +
+                  (BOARD_X - OUTERBORDER_X) * scale;
+        float y = SPECTATOR_HEADER_HEIGHT + (i / columns) * cellSize + SPECTATOR_PADDING +
+                  (BOARD_Y - OUTERBORDER_Y) * scale;
+
+        for (int square = 0; square < BOARD_SIZE * BOARD_SIZE; square++)
+        {
+            uint64_t bit = (uint64_t)1 << square;
+            Vector2 position = {
+                x + (square % BOARD_SIZE) * SQUARE_SIZE * scale,
+                y + (square / BOARD_SIZE) * SQUARE_SIZE * scale };
+
+            if (board.black & bit)
+                queueSprite(SPRITE_BLACK_DISC, position, SPRITE_SIZE * scale);
+            else if (board.white & bit)
+                queueSprite(SPRITE_WHITE_DISC, position, SPRITE_SIZE * scale);
+        }
+
+        if (isSquareValid(board.lastMove))
+            queueSprite(SPRITE_BEST_MOVE,
+                { x + board.lastMove.x * SQUARE_SIZE * scale,
+                 y + board.lastMove.y * SQUARE_SIZE * scale },
+                SPRITE_SIZE * scale);
+    }
+
+    flushSprites();
+
+    if (showDebugOverlay)
+        drawDebugOverlay();
 
     EndDrawing();
 }
 
+void waitSpectatorView()
+{
+    WaitTime(FRAME_TIME);
+    PollInputEvents();
+}
+
 Square getSquareOnMousePointer()
 {
     Vector2 mousePosition = GetMousePosition();
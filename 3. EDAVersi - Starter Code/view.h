@@ -8,7 +8,11 @@
 #ifndef VIEW_H
 #define VIEW_H
 
+#include <vector>
+
 #include "model.h"
+#include "review.h"
+#include "searchinfo.h"
 
 /**
  * @brief Initializes a game view.
@@ -27,6 +31,99 @@ void freeView();
  */
 void drawView(GameModel &model);
 
+/**
+ * @brief Indicates whether something visible changed since the last drawn
+ * frame (board, turn, displayed timers or window).
+ *
+ * @param model The game model.
+ * @return true or false.
+ */
+bool isViewDirty(GameModel &model);
+
+/**
+ * @brief Forces the next frame to be drawn.
+ */
+void invalidateView();
+
+/**
+ * @brief Sets the search progress shown on the info panel, with its best
+ * move highlighted on the board.
+ *
+ * The snapshot is read when drawing, so it must stay valid until it is
+ * replaced; a new sequence number makes the view dirty.
+ *
+ * @param info The snapshot, or nullptr to hide it.
+ */
+void setSearchInfo(const SearchInfo *info);
+
+/**
+ * @brief Sets the move scores drawn on the hint discs.
+ *
+ * Same lifetime rules as setSearchInfo(); the scored moves are the lines
+ * of the snapshot.
+ *
+ * @param info The snapshot, or nullptr to hide the scores.
+ */
+void setHintInfo(const SearchInfo *info);
+
+/**
+ * @brief Sets the post-game review drawn as a chart of the score lost by
+ * every move, with the current ply marked.
+ *
+ * The moves are read when drawing, so they must stay valid until replaced.
+ *
+ * @param moves The reviewed moves, or nullptr while the review runs.
+ * @param progress The number of moves reviewed so far.
+ * @param total The number of moves under review (0: no review).
+ * @param ply The current ply of the history.
+ */
+void setReview(const std::vector<ReviewMove> *moves, int progress, int total, int ply);
+
+/**
+ * @brief Shows the position editor: the player to move instead of the
+ * play buttons, and no hints.
+ *
+ * @param editing Whether the board is being edited.
+ */
+void setEditMode(bool editing);
+
+/**
+ * @brief Shows or hides the debug overlay (draw calls and sprites per frame).
+ */
+void toggleDebugOverlay();
+
+/**
+ * @brief Processes input events without drawing.
+ *
+ * Sleeps for one frame while a search or the review runs. Otherwise
+ * blocks until an event arrives or, with a running timer, until its
+ * displayed second changes.
+ *
+ * @param model The game model.
+ * @param searching Whether a background search (AI, hints or analysis) runs.
+ */
+void waitView(GameModel &model, bool searching);
+
+/**
+ * @brief Reads the tournament boards for the spectator view.
+ *
+ * Never blocks the workers: a board being written keeps its last copy.
+ *
+ * @return true if something visible changed since the last call.
+ */
+bool readSpectatorBoards();
+
+/**
+ * @brief Draws the spectator view: every tournament board, scaled down in
+ * a grid, with the results so far.
+ */
+void drawSpectatorView();
+
+/**
+ * @brief Waits one frame and processes input events, without drawing.
+ */
+void waitSpectatorView();
+
 /**
  * @brief Returns the square over the mouse pointer.
  *